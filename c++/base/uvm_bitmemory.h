@@ -18,12 +18,31 @@
 
 #include <stdio.h>
 #include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 
 #include "base/uvm_misc.h"
 #include "base/uvm_bitstream.h"
+#include "base/uvm_metrics.h"
+
+// Result of uvm_bitmemory::compare_parallel(). ranges holds the mismatching
+// rows as sorted, non-overlapping [first, last) address ranges.
+class uvm_shared_bitmemory;
+
+struct uvm_bitmemory_diff_report {
+  std::vector<std::pair<u_int32_t, u_int32_t>> ranges;
+  u64 mismatches = 0;     // number of mismatching rows in ranges
+  bool truncated = false; // stopped early at max_mismatches
+  bool geometry_differs = false;
+
+  bool equal() const { return !geometry_differs && mismatches == 0; }
+};
 
 class uvm_bitmemory {
 
+  friend class uvm_shared_bitmemory;
+
   uvm_bitstream ** pacbv;
   std::string psMemoryName = "uvm_bitmemory";
 
@@ -31,10 +50,115 @@ class uvm_bitmemory {
   u_int32_t lDepth;
   u_int32_t lBitCnt;
 
+  // Block tracking. Rows are grouped in blocks of (1 << lBlockShift) rows.
+  // m_dirty collects blocks touched since the last checkpoint(), m_stale the
+  // blocks whose digest must be recomputed. m_tree is a binary hash tree kept
+  // in heap order: leaves at [m_leaves, 2*m_leaves), root at index 1.
+  u_int32_t lBlockShift = 6;
+  bool bDigestOn = false;
+  mutable std::vector<u64> m_dirty;
+  mutable std::vector<u64> m_stale;
+  mutable bool bAnyStale = false;
+  mutable std::vector<u64> m_tree;
+  u_int32_t m_leaves = 0;
+
+  static u64 m_mix(u64 h) {
+    h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  u_int32_t m_num_blocks() const { return lDepth ? ((lDepth - 1) >> lBlockShift) + 1 : 0; }
+
+  u64 m_hash_block(u_int32_t blk) const {
+    u_int32_t first = blk << lBlockShift;
+    u_int32_t last = std::min(lDepth, first + (1u << lBlockShift));
+    u64 h = m_mix(blk + 0x9e3779b97f4a7c15ULL);
+    for (u_int32_t a = first; a < last; a++) {
+      const u32* w = pacbv[a]->get_words_ptr();
+      for (u32 i = 0, n = pacbv[a]->get_word_size(); i < n; i++)
+        h = m_mix(h ^ w[i]) + a;
+    }
+    return h;
+  }
+
+  void m_refresh_digest() const {
+    if (!bAnyStale) return;
+    u_int32_t nblk = m_num_blocks();
+    std::vector<u_int32_t> nodes;
+    for (u_int32_t i = 0; i < m_stale.size(); i++) {
+      for (u64 bits = m_stale[i]; bits; bits &= bits - 1) {
+        u_int32_t blk = (i << 6) + __builtin_ctzll(bits);
+        if (blk >= nblk) continue;
+        m_tree[m_leaves + blk] = m_hash_block(blk);
+        nodes.push_back(m_leaves + blk);
+      }
+    }
+    // Rebuild the ancestors of the rehashed leaves one level at a time.
+    while (!nodes.empty() && nodes.front() > 1) {
+      for (u_int32_t & n : nodes) n >>= 1;
+      nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+      for (u_int32_t n : nodes)
+        m_tree[n] = m_mix(m_tree[2 * n] ^ (m_tree[2 * n + 1] * 0x9e3779b97f4a7c15ULL));
+    }
+    std::fill(m_stale.begin(), m_stale.end(), 0);
+    bAnyStale = false;
+  }
+
+  void m_take_tracking(uvm_bitmemory & bm) noexcept {
+    lBlockShift = bm.lBlockShift;
+    bDigestOn = bm.bDigestOn;
+    bAnyStale = bm.bAnyStale;
+    m_dirty = std::move(bm.m_dirty);
+    m_stale = std::move(bm.m_stale);
+    m_tree = std::move(bm.m_tree);
+    m_leaves = bm.m_leaves;
+    bm.bDigestOn = false;
+    bm.bAnyStale = false;
+    bm.m_leaves = 0;
+  }
+
+  void m_diff_node(const uvm_bitmemory & cbm, u_int32_t n, std::vector<u_int32_t> & blocks) const {
+    if (m_tree[n] == cbm.m_tree[n]) return;
+    if (n >= m_leaves) {
+      if (n - m_leaves < m_num_blocks()) blocks.push_back(n - m_leaves);
+      return;
+    }
+    m_diff_node(cbm, 2 * n, blocks);
+    m_diff_node(cbm, 2 * n + 1, blocks);
+  }
+
   public:
 
   uvm_bitmemory(u_int32_t lSetWidth, u_int32_t lSetDepth, const char * psName = "undef",int iUseName=0, const char *a =0);
   uvm_bitmemory(const std::vector <uvm_bitstream> & pkt, const char * psName = "undef",int iUseName=0);
+
+  // Adopts the packet rows: each row takes over the word array of the
+  // corresponding bitstream instead of copying it. pkt is left holding empty
+  // bitstreams. Width is the widest row, bitCnt the total number of bits.
+  // Counts the rows in ~uvm.bitmemory.rows~ while metrics are enabled.
+  uvm_bitmemory(std::vector <uvm_bitstream> && pkt, const char * psName = "undef",int iUseName=0)
+      : psMemoryName(psName), lWidth(0), lDepth(pkt.size()), lBitCnt(0) {
+    pacbv = new uvm_bitstream*[lDepth];
+    for (u_int32_t a = 0; a < lDepth; a++) {
+      lWidth = std::max(lWidth, pkt[a].get_size());
+      lBitCnt += pkt[a].get_size();
+      pacbv[a] = new uvm_bitstream(std::move(pkt[a]));
+      if (iUseName) pacbv[a]->set_name(psMemoryName + "[" + std::to_string(a) + "]");
+    }
+    if (uvm_metrics::is_enabled())
+      uvm_framework_metrics::get()->bitmemory_rows.inc(lDepth);
+  }
+
+  // Takes over the rows and tracking state of bm, which is left empty.
+  uvm_bitmemory(uvm_bitmemory && bm) noexcept
+      : pacbv(bm.pacbv), psMemoryName(std::move(bm.psMemoryName)),
+        lWidth(bm.lWidth), lDepth(bm.lDepth), lBitCnt(bm.lBitCnt) {
+    m_take_tracking(bm);
+    bm.pacbv = nullptr;
+    bm.lWidth = bm.lDepth = bm.lBitCnt = 0;
+  }
   void init(u_int32_t lSetWidth, u_int32_t lSetDepth, const char * psName = "undef",int iUseName=0, const char *a=0);
 
   uvm_bitmemory();
@@ -43,6 +167,18 @@ class uvm_bitmemory {
 
   void resize(u_int32_t newWidth);
 
+  // In-place variant of resize(): rows whose word count does not change keep
+  // their storage and the others are reallocated once each (see
+  // uvm_bitstream::resize); the low bits of every row are kept. lBitCnt
+  // becomes the total bit count, as for a memory built from packets, and
+  // tracking, if enabled, starts over with every block dirty.
+  void resize_in_place(u_int32_t newWidth) {
+    for (u_int32_t a = 0; a < lDepth; a++) pacbv[a]->resize(newWidth);
+    lWidth = newWidth;
+    lBitCnt = newWidth * lDepth;
+    if (bDigestOn) enable_digest(true, lBlockShift);
+  }
+
   u_int32_t getWidth() const;
 
   u_int32_t getDepth() const;
@@ -57,12 +193,260 @@ class uvm_bitmemory {
 
   uvm_bitstream & operator[] (uvm_bitstream cbv) const;
 
+  // Row access through a non-const memory; marks the row's block dirty and
+  // stale while tracking is enabled, since the row may be written.
+  uvm_bitstream & operator[] (u_int32_t lAddr) {
+    mark_dirty(lAddr);
+    return static_cast<const uvm_bitmemory &>(*this)[lAddr];
+  }
+
+  uvm_bitstream & operator[] (uvm_bitstream cbv) {
+    mark_dirty(cbv.get_u32());
+    return static_cast<const uvm_bitmemory &>(*this)[cbv];
+  }
+
   uvm_bitmemory & operator = (const uvm_bitmemory & bm);
 
+  uvm_bitmemory & operator = (uvm_bitmemory && bm) noexcept {
+    if (this == &bm) return *this;
+    for (u_int32_t a = 0; a < lDepth; a++) delete pacbv[a];
+    delete [] pacbv;
+    pacbv = bm.pacbv;
+    psMemoryName = std::move(bm.psMemoryName);
+    lWidth = bm.lWidth;
+    lDepth = bm.lDepth;
+    lBitCnt = bm.lBitCnt;
+    m_take_tracking(bm);
+    bm.pacbv = nullptr;
+    bm.lWidth = bm.lDepth = bm.lBitCnt = 0;
+    return *this;
+  }
+
   bool operator == (const uvm_bitmemory & cbm) const;
   void copy(unsigned char *, u_int32_t len) const;
   void diffBM(const uvm_bitmemory & cmpuvm_transactionBM);
 
+  // Dirty-block tracking and block digests
+  //---------------------------------------
+  //
+  // Tracking is off unless enable_digest() is called. Once on, operator[] on
+  // a non-const memory, load_row() and uvm_shared_bitmemory mark the rows
+  // they hand out or write, so the digests used by digest_equal(),
+  // diff_blocks() and diff_rows() are rehashed from the current rows. A row
+  // written through operator[] on a const reference is not seen; follow such
+  // writes with mark_dirty() on those rows, or invalidate_digest().
+
+  // Enables tracking with blocks of 2^blockShift rows. All blocks start out
+  // dirty and stale so the first get_digest() hashes the whole memory once.
+  void enable_digest(bool on = true, u_int32_t blockShift = 6) {
+    bDigestOn = on;
+    m_dirty.clear(); m_stale.clear(); m_tree.clear();
+    m_leaves = 0;
+    bAnyStale = false;
+    if (!on) return;
+    lBlockShift = blockShift;
+    u_int32_t nblk = m_num_blocks();
+    m_leaves = 1;
+    while (m_leaves < nblk) m_leaves <<= 1;
+    m_dirty.assign((nblk + 63) / 64, ~0ULL);
+    m_stale.assign((nblk + 63) / 64, ~0ULL);
+    m_tree.assign(2 * m_leaves, 0);
+    bAnyStale = nblk != 0;
+  }
+
+  bool is_digest_enabled() const { return bDigestOn; }
+
+  u_int32_t get_block_rows() const { return 1u << lBlockShift; }
+
+  void mark_dirty(u_int32_t lAddr) const {
+    if (!bDigestOn || lAddr >= lDepth) return;
+    u_int32_t blk = lAddr >> lBlockShift;
+    u64 bit = 1ULL << (blk & 63);
+    m_dirty[blk >> 6] |= bit;
+    m_stale[blk >> 6] |= bit;
+    bAnyStale = true;
+  }
+
+  // Marks every block dirty and stale, as after writes through a const
+  // operator[] that were not recorded one by one.
+  void invalidate_digest() const {
+    if (!bDigestOn) return;
+    std::fill(m_dirty.begin(), m_dirty.end(), ~0ULL);
+    std::fill(m_stale.begin(), m_stale.end(), ~0ULL);
+    bAnyStale = m_num_blocks() != 0;
+  }
+
+  // Root of the block hash tree; only stale blocks are rehashed.
+  u64 get_digest() const {
+    if (!bDigestOn || m_tree.empty()) return 0;
+    m_refresh_digest();
+    return m_tree[1];
+  }
+
+  // Digest compare. A 64-bit collision is accepted as the (negligible) cost
+  // of not reading the rows; use diffBM() when a proof of equality is needed.
+  // Without digests on both sides this is operator==.
+  bool digest_equal(const uvm_bitmemory & cbm) const {
+    if (lWidth != cbm.lWidth || lDepth != cbm.lDepth) return false;
+    if (!bDigestOn || !cbm.bDigestOn || lBlockShift != cbm.lBlockShift) return *this == cbm;
+    return get_digest() == cbm.get_digest();
+  }
+
+  // Blocks whose digests differ, found by descending only into differing
+  // subtrees. Falls back to every block when the geometries do not match.
+  void diff_blocks(const uvm_bitmemory & cbm, std::vector<u_int32_t> & blocks) const {
+    blocks.clear();
+    if (!bDigestOn || !cbm.bDigestOn || lBlockShift != cbm.lBlockShift || lDepth != cbm.lDepth) {
+      for (u_int32_t b = 0, n = m_num_blocks(); b < n; b++) blocks.push_back(b);
+      return;
+    }
+    get_digest();
+    cbm.get_digest();
+    if (!m_tree.empty()) m_diff_node(cbm, 1, blocks);
+  }
+
+  // Addresses of the rows that differ, walking only the differing blocks.
+  void diff_rows(const uvm_bitmemory & cbm, std::vector<u_int32_t> & addrs) const {
+    std::vector<u_int32_t> blocks;
+    addrs.clear();
+    diff_blocks(cbm, blocks);
+    for (u_int32_t blk : blocks) {
+      u_int32_t first = blk << lBlockShift;
+      u_int32_t last = std::min(std::min(lDepth, cbm.lDepth), first + (1u << lBlockShift));
+      for (u_int32_t a = first; a < last; a++)
+        if (*pacbv[a] != *cbm.pacbv[a]) addrs.push_back(a);
+    }
+  }
+
+  // Parallel compare
+  //-----------------
+
+  // Compares against cbm on nthreads worker threads (0 = hardware
+  // concurrency). The address space is split into chunks of chunkRows rows
+  // and workers claim chunks in address order. Rows are compared word-wise with memcmp. With max_mismatches != 0
+  // the workers stop once that many rows mismatched and the report is cut to
+  // the lowest max_mismatches rows found.
+  //
+  // Every row is compared unless digestFresh is set, which the caller may
+  // only do when both sides have digests enabled and every write since they
+  // were enabled has been recorded (see mark_dirty()); then only the blocks
+  // reported by diff_blocks() are walked.
+  void compare_parallel(const uvm_bitmemory & cbm, uvm_bitmemory_diff_report & rpt,
+                        u_int32_t nthreads = 0, u64 max_mismatches = 0,
+                        u_int32_t chunkRows = 4096, bool digestFresh = false) const {
+    rpt = uvm_bitmemory_diff_report();
+    if (lWidth != cbm.lWidth || lDepth != cbm.lDepth) {
+      rpt.geometry_differs = true;
+      return;
+    }
+
+    std::vector<std::pair<u_int32_t, u_int32_t>> chunks;
+    if (digestFresh && bDigestOn && cbm.bDigestOn && lBlockShift == cbm.lBlockShift) {
+      std::vector<u_int32_t> blocks;
+      diff_blocks(cbm, blocks);
+      for (u_int32_t blk : blocks) {
+        u_int32_t first = blk << lBlockShift;
+        chunks.emplace_back(first, std::min(lDepth, first + (1u << lBlockShift)));
+      }
+    } else {
+      if (chunkRows == 0) chunkRows = 4096;
+      for (u_int32_t first = 0; first < lDepth; first += std::min(chunkRows, lDepth - first))
+        chunks.emplace_back(first, first + std::min(chunkRows, lDepth - first));
+    }
+    if (chunks.empty()) return;
+
+    if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+    nthreads = std::min<u_int32_t>(nthreads, chunks.size());
+
+    std::atomic<size_t> next(0);
+    std::atomic<u64> found(0);
+    std::atomic<bool> stop(false);
+    std::vector<std::vector<std::pair<u_int32_t, u_int32_t>>> per_chunk(chunks.size());
+
+    auto worker = [&]() {
+      for (size_t c; !stop.load(std::memory_order_relaxed) && (c = next.fetch_add(1)) < chunks.size(); ) {
+        auto & out = per_chunk[c];
+        u64 local = 0;
+        for (u_int32_t a = chunks[c].first; a < chunks[c].second; a++) {
+          const uvm_bitstream & l = *pacbv[a];
+          const uvm_bitstream & r = *cbm.pacbv[a];
+          if (l.get_word_size() == r.get_word_size() &&
+              memcmp(l.get_words_ptr(), r.get_words_ptr(), sizeof(u32) * l.get_word_size()) == 0)
+            continue;
+          if (!out.empty() && out.back().second == a) out.back().second = a + 1;
+          else out.emplace_back(a, a + 1);
+          local++;
+        }
+        if (local && max_mismatches && found.fetch_add(local) + local >= max_mismatches)
+          stop.store(true, std::memory_order_relaxed);
+      }
+    };
+
+    std::vector<std::thread> pool;
+    for (u_int32_t t = 1; t < nthreads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto & t : pool) t.join();
+
+    // Chunks are in address order, so concatenating them keeps the ranges
+    // sorted; only ranges that meet at a chunk boundary need merging.
+    for (auto & out : per_chunk) {
+      for (auto & r : out) {
+        if (max_mismatches && rpt.mismatches >= max_mismatches) {
+          rpt.truncated = true;
+          return;
+        }
+        u64 take = r.second - r.first;
+        if (max_mismatches && rpt.mismatches + take > max_mismatches) {
+          take = max_mismatches - rpt.mismatches;
+          rpt.truncated = true;
+        }
+        u_int32_t last = r.first + take;
+        if (!rpt.ranges.empty() && rpt.ranges.back().second == r.first) rpt.ranges.back().second = last;
+        else rpt.ranges.emplace_back(r.first, last);
+        rpt.mismatches += take;
+      }
+    }
+    if (stop.load() && next.load() < chunks.size()) rpt.truncated = true;
+  }
+
+  // Row images for uvm_checkpoint. row_words() reads without marking the row
+  // dirty; load_row() overwrites row lAddr from lCount words as returned by
+  // row_words() on a memory of the same width, and marks it dirty.
+  const u32 * row_words(u_int32_t lAddr) const { return pacbv[lAddr]->get_words_ptr(); }
+
+  void load_row(u_int32_t lAddr, const u32 * pWords, u32 lCount) {
+    pacbv[lAddr]->set_words(pWords, lCount);
+    mark_dirty(lAddr);
+  }
+
+  // Starts a new incremental-scoreboarding interval.
+  void checkpoint() { std::fill(m_dirty.begin(), m_dirty.end(), 0); }
+
+  // Blocks touched since the last checkpoint(), in ascending order.
+  void get_dirty_blocks(std::vector<u_int32_t> & blocks) const {
+    blocks.clear();
+    u_int32_t nblk = m_num_blocks();
+    for (u_int32_t i = 0; i < m_dirty.size(); i++)
+      for (u64 bits = m_dirty[i]; bits; bits &= bits - 1) {
+        u_int32_t blk = (i << 6) + __builtin_ctzll(bits);
+        if (blk < nblk) blocks.push_back(blk);
+      }
+  }
+
+  // Row ranges [first, last) touched since the last checkpoint(). Adjacent
+  // dirty blocks are merged into one range.
+  void get_changes_since_checkpoint(std::vector<std::pair<u_int32_t, u_int32_t>> & ranges) const {
+    std::vector<u_int32_t> blocks;
+    ranges.clear();
+    get_dirty_blocks(blocks);
+    for (u_int32_t blk : blocks) {
+      u_int32_t first = blk << lBlockShift;
+      u_int32_t last = std::min(lDepth, first + (1u << lBlockShift));
+      if (!ranges.empty() && ranges.back().second == first) ranges.back().second = last;
+      else ranges.emplace_back(first, last);
+    }
+  }
+
  };
 
 extern std::ostream & operator << (std::ostream &, const uvm_bitmemory &);
@@ -25,6 +25,7 @@
 #include <iomanip>
 #include <sstream>
 #include <cstdint>
+#include <algorithm>
 
 // Type definitions for convenience
 typedef uint32_t u32;
@@ -265,6 +266,19 @@ public:
      */
     uvm_bitstream(const uvm_bitproxy& cbp);
 
+    /**
+     * Move constructor that takes over the word array of another bitstream.
+     * The source is left empty (size 0) but valid.
+     * @param cbv The bitstream to move from.
+     */
+    uvm_bitstream(uvm_bitstream&& cbv) noexcept
+        : lSize(cbv.lSize), la(cbv.la), lWordCount(cbv.lWordCount),
+          lDisplayMode(cbv.lDisplayMode), psName(std::move(cbv.psName)) {
+        cbv.la = nullptr;
+        cbv.lSize = 0;
+        cbv.lWordCount = 0;
+    }
+
     /**
      * Default constructor that initializes an empty bitstream.
      */
@@ -290,6 +304,25 @@ public:
      */
     void init(u32 lSizeAssign);
 
+    /**
+     * Changes the size of the bitstream, keeping the value of the low bits.
+     * The word array is reused when the word count does not change; otherwise
+     * it is reallocated once and the common words are copied over.
+     * @param lNewSize The new size of the bitstream in bits.
+     */
+    void resize(u32 lNewSize) {
+        u32 lNewWordCount = (lNewSize + 31) / 32;
+        if (lNewWordCount != lWordCount) {
+            u32* pNew = lNewWordCount ? new u32[lNewWordCount]() : nullptr;
+            if (la && pNew) memcpy(pNew, la, sizeof(*la) * std::min(lWordCount, lNewWordCount));
+            delete[] la;
+            la = pNew;
+            lWordCount = lNewWordCount;
+        }
+        lSize = lNewSize;
+        if (lWordCount) clip();
+    }
+
     /**
      * Clears a specific bit in the bitstream (sets it to 0).
      * @param lBit The bit index to clear.
@@ -340,6 +373,26 @@ public:
      */
     uvm_bitstream& operator=(const uvm_bitstream& cbvRef);
 
+    /**
+     * Move assignment operator. Takes over the word array of another bitstream;
+     * like copy assignment, the name and display mode of this bitstream are kept.
+     * The source is left empty (size 0) but valid.
+     * @param cbvRef The bitstream to move from.
+     * @returns Reference to the current bitstream.
+     */
+    uvm_bitstream& operator=(uvm_bitstream&& cbvRef) noexcept {
+        if (this != &cbvRef) {
+            delete[] la;
+            la = cbvRef.la;
+            lSize = cbvRef.lSize;
+            lWordCount = cbvRef.lWordCount;
+            cbvRef.la = nullptr;
+            cbvRef.lSize = 0;
+            cbvRef.lWordCount = 0;
+        }
+        return *this;
+    }
+
     // Shift operators
     /**
      * Right shift operator.
@@ -526,6 +579,20 @@ public:
      */
     const u32* get_words_ptr() const;
 
+    /**
+     * Overwrites the word array from a raw image, as saved from
+     * get_words_ptr() of a bitstream of the same size (see uvm_checkpoint).
+     * Words past lCount are cleared; bits above the size are masked off.
+     * @param pWords The words to copy.
+     * @param lCount The number of words at pWords.
+     */
+    void set_words(const u32* pWords, u32 lCount) {
+        u32 n = std::min(lCount, lWordCount);
+        if (n) memcpy(la, pWords, sizeof(*la) * n);
+        if (n < lWordCount) memset(la + n, 0, sizeof(*la) * (lWordCount - n));
+        if (lWordCount) clip();
+    }
+
     /**
      * Retrieves a sub-field of the bitstream as a new bitstream.
      * @param lThisUpper The upper bit index of the sub-field.
@@ -0,0 +1,612 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_CHECKPOINT_H
+#define UVM_CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <tuple>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "base/uvm_component.h"
+#include "base/uvm_resource.h"
+#include "base/uvm_objection.h"
+#include "base/uvm_bitmemory.h"
+#include "base/uvm_phase.h"
+#include "base/uvm_cmdline_processor.h"
+
+//------------------------------------------------------------------------------
+//
+// Title: Checkpoint file format
+//
+// A checkpoint is a 24-byte header followed by records, written one at a
+// time and never revisited, so a writer needs no more memory than the largest
+// single row or field image. Every record starts on an 8-byte boundary, so a
+// reader can mmap the file and use payloads (memory rows in particular) in
+// place:
+//
+//| header   char magic[8] = "UVMCKPT1"; u32 version; u32 reserved; u64 sim_time
+//| record   u32 kind; u32 name_len; u64 data_len;
+//|          name[name_len], zero pad to 8; data[data_len], zero pad to 8
+//| ...
+//| record   kind END
+//
+// Integers are in host byte order; a checkpoint is restored on the machine
+// type that wrote it.
+//
+//| kind        name              data
+//| PHASE       phase name        -
+//| COMPONENT   full name         uvm_object::pack_bytes image
+//| MEMORY      registered name   u32 width, depth, words/row, 0; rows
+//| RESOURCE    resource name     u32 precedence, scope_len, type_len, value_len;
+//|                               scope regex, value type, value image
+//| OBJECTION   objection name    { u32 count, path_len; object full name }...
+//------------------------------------------------------------------------------
+
+struct uvm_checkpoint_format {
+    enum kind_e : uint32_t { END = 0, PHASE, COMPONENT, MEMORY, RESOURCE, OBJECTION };
+
+    static constexpr char MAGIC[8] = {'U', 'V', 'M', 'C', 'K', 'P', 'T', '1'};
+    static constexpr uint32_t VERSION = 1;
+
+    struct header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t sim_time;
+    };
+
+    struct record_header {
+        uint32_t kind;
+        uint32_t name_len;
+        uint64_t data_len;
+    };
+
+    static uint64_t pad8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_checkpoint_writer
+//
+// Streams records to a checkpoint file. A record is either written whole
+// (<write>) or opened with its final length (<begin>), filled with
+// <append> and closed with <end>.
+//------------------------------------------------------------------------------
+
+class uvm_checkpoint_writer {
+public:
+    bool open(const std::string& file, uint64_t sim_time) {
+        m_os.open(file, std::ios::binary | std::ios::trunc);
+        if (!m_os) return false;
+        uvm_checkpoint_format::header h = {};
+        std::memcpy(h.magic, uvm_checkpoint_format::MAGIC, sizeof(h.magic));
+        h.version = uvm_checkpoint_format::VERSION;
+        h.sim_time = sim_time;
+        m_os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        return bool(m_os);
+    }
+
+    void begin(uint32_t kind, const std::string& name, uint64_t data_len) {
+        uvm_checkpoint_format::record_header rh = {kind, uint32_t(name.size()), data_len};
+        m_os.write(reinterpret_cast<const char*>(&rh), sizeof(rh));
+        m_os.write(name.data(), name.size());
+        m_pad(name.size());
+        m_left = data_len;
+    }
+
+    void append(const void* p, size_t n) {
+        m_os.write(static_cast<const char*>(p), n);
+        m_left -= n;
+    }
+
+    void end() {
+        // a short record is zero-filled up to the length announced in begin()
+        for (; m_left; m_left--) m_os.put('\0');
+        m_pad(m_os.tellp());
+    }
+
+    void write(uint32_t kind, const std::string& name, const void* p = nullptr, size_t n = 0) {
+        begin(kind, name, n);
+        if (n) append(p, n);
+        end();
+    }
+
+    bool close() {
+        write(uvm_checkpoint_format::END, "");
+        m_os.close();
+        return !m_os.fail();
+    }
+
+private:
+    void m_pad(uint64_t n) {
+        static const char zeros[8] = {};
+        m_os.write(zeros, uvm_checkpoint_format::pad8(n) - n);
+    }
+
+    std::ofstream m_os;
+    uint64_t m_left = 0;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_checkpoint_reader
+//
+// Maps a checkpoint file read-only and walks its records in place; the
+// name and data of a <record> point into the mapping and stay valid until
+// the reader is destroyed.
+//------------------------------------------------------------------------------
+
+class uvm_checkpoint_reader {
+public:
+    struct record {
+        uint32_t kind = uvm_checkpoint_format::END;
+        std::string name;
+        const char* data = nullptr;
+        uint64_t size = 0;
+    };
+
+    ~uvm_checkpoint_reader() {
+        if (m_base) munmap(const_cast<char*>(m_base), m_size);
+    }
+
+    bool open(const std::string& file) {
+        int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(uvm_checkpoint_format::header)) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                m_base = static_cast<const char*>(p);
+                m_size = st.st_size;
+            }
+        }
+        ::close(fd);
+        if (!m_base) return false;
+        const uvm_checkpoint_format::header* h = reinterpret_cast<const uvm_checkpoint_format::header*>(m_base);
+        if (std::memcmp(h->magic, uvm_checkpoint_format::MAGIC, sizeof(h->magic)) != 0 ||
+            h->version != uvm_checkpoint_format::VERSION)
+            return false;
+        m_time = h->sim_time;
+        m_pos = sizeof(*h);
+        return true;
+    }
+
+    uint64_t get_sim_time() const { return m_time; }
+
+    // Function: next
+    //
+    // Moves to the next record; false at the END record or at a truncated or
+    // corrupt record (see <is_complete>).
+    bool next(record& r) {
+        uvm_checkpoint_format::record_header rh;
+        if (m_pos + sizeof(rh) > m_size) return false;
+        std::memcpy(&rh, m_base + m_pos, sizeof(rh));
+        uint64_t name_at = m_pos + sizeof(rh);
+        uint64_t data_at = name_at + uvm_checkpoint_format::pad8(rh.name_len);
+        if (data_at > m_size || rh.data_len > m_size - data_at) return false;
+        m_pos = data_at + uvm_checkpoint_format::pad8(rh.data_len);
+        if (rh.kind == uvm_checkpoint_format::END) {
+            m_complete = true;
+            return false;
+        }
+        r.kind = rh.kind;
+        r.name.assign(m_base + name_at, rh.name_len);
+        r.data = m_base + data_at;
+        r.size = rh.data_len;
+        return true;
+    }
+
+    // Function: is_complete
+    //
+    // Whether <next> reached the END record, i.e. the writer finished.
+    bool is_complete() const { return m_complete; }
+
+private:
+    const char* m_base = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_pos = 0;
+    uint64_t m_time = 0;
+    bool m_complete = false;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_checkpoint
+//
+// Snapshot of testbench state at a phase boundary, restored into a freshly
+// built environment so that tests sharing a prefix (typically reset and
+// configuration) run it once:
+//
+//| +UVM_CHECKPOINT_SAVE=<file>       save when <phase> ends
+//| +UVM_CHECKPOINT_RESTORE=<file>    restore when pre_reset ends, then jump
+//|                                   to the phase after the saved one
+//| +UVM_CHECKPOINT_PHASE=<phase>     default: post_configure
+//
+// A checkpoint holds:
+//
+// - the fields of every component below the top, through field automation
+//   (<uvm_object::pack_bytes>, so ~do_pack~/~do_unpack~ overrides are used)
+// - the contents of each <uvm_bitmemory> registered with <add_memory>
+// - every resource in <uvm_resource_pool> whose value is trivially copyable
+//   or a std::string; resources missing from the new environment are
+//   recreated, provided their type is instantiated in the program
+// - the source counts of uvm_test_done and each objection registered with
+//   <add_objection>; the counts are raised under "checkpoint restore" to
+//   carry them over the jump, and dropped again once the phase after the
+//   saved one has started, since no component of the new environment
+//   drops them
+// - the simulation time, read and restored through <set_time_hooks>
+//
+// Components, memories and objections are matched by name, so the new
+// environment must build the same hierarchy. State that is not listed here
+// (sequences in flight, pointers, transactions queued in ports) is not
+// saved; the boundary should be one where none is pending.
+//------------------------------------------------------------------------------
+
+class uvm_checkpoint {
+public:
+    static uvm_checkpoint* get() {
+        static uvm_checkpoint inst;
+        return &inst;
+    }
+
+    // Function: add_memory
+    //
+    // Includes ~mem~ in checkpoints under ~name~.
+    void add_memory(const std::string& name, uvm_bitmemory* mem) { m_memories[name] = mem; }
+
+    // Function: add_objection
+    //
+    // Includes the counts of ~obj~ in checkpoints, under its name.
+    void add_objection(uvm_objection* obj) {
+        if (std::find(m_objections.begin(), m_objections.end(), obj) == m_objections.end())
+            m_objections.push_back(obj);
+    }
+
+    // Function: set_time_hooks
+    //
+    // How to read the simulation time when saving, and how to advance it to
+    // the saved time when restoring. Installed by the time scheduler; without
+    // hooks, time 0 is saved and the saved time is only reported.
+    void set_time_hooks(std::function<uint64_t()> now, std::function<void(uint64_t)> advance) {
+        m_now = now;
+        m_advance = advance;
+    }
+
+    // Function: save
+    //
+    // Writes the state below ~top~ to ~file~, tagged with ~phase~.
+    bool save(const std::string& file, uvm_component* top, const std::string& phase) {
+        uvm_checkpoint_writer w;
+        if (!w.open(file, m_now ? m_now() : 0)) {
+            uvm_error("UVM/CHECKPOINT", "Cannot write checkpoint file " + file);
+            return false;
+        }
+        w.write(uvm_checkpoint_format::PHASE, phase);
+
+        std::vector<uvm_component*> comps;
+        m_get_components(top, comps);
+        for (uvm_component* c : comps) {
+            std::vector<uint8_t> bytes;
+            c->pack_bytes(bytes);
+            if (!bytes.empty()) w.write(uvm_checkpoint_format::COMPONENT, c->get_full_name(), bytes.data(), bytes.size());
+        }
+
+        for (const auto& [name, mem] : m_memories) {
+            uint32_t depth = mem->getDepth();
+            uint32_t wpr = (mem->getWidth() + 31) / 32;
+            uint32_t geom[4] = {mem->getWidth(), depth, wpr, 0};
+            w.begin(uvm_checkpoint_format::MEMORY, name, sizeof(geom) + uint64_t(depth) * wpr * sizeof(u32));
+            w.append(geom, sizeof(geom));
+            for (uint32_t a = 0; a < depth; a++)
+                w.append(mem->row_words(a), wpr * sizeof(u32));
+            w.end();
+        }
+
+        std::vector<uvm_resource_base*> rsrcs;
+        uvm_resource_pool::get()->m_get_resources(rsrcs);
+        m_skipped = 0;
+        for (uvm_resource_base* r : rsrcs) {
+            std::string value;
+            if (!r->m_save_value(value)) {
+                m_skipped++;
+                continue;
+            }
+            std::string scope = r->get_scope(), type = r->m_type_name();
+            uint32_t hdr[4] = {r->precedence, uint32_t(scope.size()), uint32_t(type.size()), uint32_t(value.size())};
+            w.begin(uvm_checkpoint_format::RESOURCE, r->get_name(), sizeof(hdr) + scope.size() + type.size() + value.size());
+            w.append(hdr, sizeof(hdr));
+            w.append(scope.data(), scope.size());
+            w.append(type.data(), type.size());
+            w.append(value.data(), value.size());
+            w.end();
+        }
+
+        for (uvm_objection* obj : m_get_objections()) {
+            std::string data;
+            for (const auto& [o, count] : obj->m_source_count) {
+                if (!o || !count) continue;
+                std::string path = o->get_full_name();
+                uint32_t hdr[2] = {uint32_t(count), uint32_t(path.size())};
+                data.append(reinterpret_cast<const char*>(hdr), sizeof(hdr));
+                data += path;
+            }
+            w.write(uvm_checkpoint_format::OBJECTION, obj->get_name(), data.data(), data.size());
+        }
+
+        if (!w.close()) {
+            uvm_error("UVM/CHECKPOINT", "Error writing checkpoint file " + file);
+            return false;
+        }
+        if (m_skipped)
+            uvm_info("UVM/CHECKPOINT", std::to_string(m_skipped) + " resources without a raw value image were not saved", UVM_LOW);
+        uvm_info("UVM/CHECKPOINT", "Saved checkpoint at end of " + phase + " to " + file, UVM_LOW);
+        return true;
+    }
+
+    // Function: restore
+    //
+    // Applies ~file~ to the environment below ~top~. Returns false if the file
+    // cannot be read or is incomplete; nothing is applied in that case.
+    // Objection counts below the saved ones are raised up to them; when
+    // called from <m_phase_ended>, those raises are dropped once the phase
+    // it jumps to has started.
+    bool restore(const std::string& file, uvm_component* top) {
+        uvm_checkpoint_reader rd;
+        if (!rd.open(file) || !m_verify(file)) {
+            uvm_error("UVM/CHECKPOINT", "Cannot read checkpoint file " + file);
+            return false;
+        }
+        m_restored_time = rd.get_sim_time();
+
+        std::unordered_map<std::string, uvm_component*> comps;
+        {
+            std::vector<uvm_component*> v;
+            m_get_components(top, v);
+            for (uvm_component* c : v) comps[c->get_full_name()] = c;
+        }
+        std::map<std::pair<std::string, std::string>, std::deque<uvm_resource_base*>> rsrcs;
+        {
+            std::vector<uvm_resource_base*> v;
+            uvm_resource_pool::get()->m_get_resources(v);
+            for (uvm_resource_base* r : v) rsrcs[{r->get_name(), r->get_scope()}].push_back(r);
+        }
+        std::unordered_map<std::string, uvm_objection*> objs;
+        for (uvm_objection* obj : m_get_objections()) objs[obj->get_name()] = obj;
+
+        int missing = 0;
+        uvm_checkpoint_reader::record r;
+        while (rd.next(r)) {
+            switch (r.kind) {
+            case uvm_checkpoint_format::PHASE:
+                m_restored_phase = r.name;
+                break;
+            case uvm_checkpoint_format::COMPONENT: {
+                auto it = comps.find(r.name);
+                if (it == comps.end()) {
+                    missing++;
+                    break;
+                }
+                std::vector<uint8_t> bytes(r.data, r.data + r.size);
+                it->second->unpack_bytes(bytes);
+                break;
+            }
+            case uvm_checkpoint_format::MEMORY: {
+                auto it = m_memories.find(r.name);
+                uint32_t geom[4] = {};
+                if (r.size >= sizeof(geom)) std::memcpy(geom, r.data, sizeof(geom));
+                if (it == m_memories.end() || r.size < sizeof(geom) ||
+                    it->second->getWidth() != geom[0] || it->second->getDepth() != geom[1] ||
+                    geom[2] != (geom[0] + 31) / 32 ||
+                    r.size < sizeof(geom) + uint64_t(geom[1]) * geom[2] * sizeof(u32)) {
+                    missing++;
+                    break;
+                }
+                // rows are 8-byte aligned in the mapping and used in place
+                const u32* rows = reinterpret_cast<const u32*>(r.data + sizeof(geom));
+                for (uint32_t a = 0; a < geom[1]; a++) it->second->load_row(a, rows + uint64_t(a) * geom[2], geom[2]);
+                break;
+            }
+            case uvm_checkpoint_format::RESOURCE: {
+                uint32_t hdr[4];
+                if (r.size < sizeof(hdr)) {
+                    missing++;
+                    break;
+                }
+                std::memcpy(hdr, r.data, sizeof(hdr));
+                if (r.size - sizeof(hdr) < uint64_t(hdr[1]) + hdr[2] + hdr[3]) {
+                    missing++;
+                    break;
+                }
+                const char* p = r.data + sizeof(hdr);
+                std::string scope(p, hdr[1]), type(p + hdr[1], hdr[2]);
+                const char* value = p + hdr[1] + hdr[2];
+                uvm_resource_base* rsrc = nullptr;
+                auto& q = rsrcs[{r.name, scope}];
+                if (!q.empty()) {
+                    rsrc = q.front();
+                    q.pop_front();
+                } else {
+                    auto h = uvm_resource_base::m_type_handles().find(type);
+                    if (h == uvm_resource_base::m_type_handles().end()) {
+                        missing++;
+                        break;
+                    }
+                    rsrc = h->second->m_create(r.name, scope);
+                    uvm_resource_pool::get()->set(rsrc);
+                }
+                rsrc->precedence = hdr[0];
+                if (!rsrc->m_restore_value(value, hdr[3])) missing++;
+                break;
+            }
+            case uvm_checkpoint_format::OBJECTION: {
+                auto it = objs.find(r.name);
+                if (it == objs.end()) {
+                    missing++;
+                    break;
+                }
+                for (uint64_t at = 0; at + 8 <= r.size;) {
+                    uint32_t hdr[2];
+                    std::memcpy(hdr, r.data + at, sizeof(hdr));
+                    if (r.size - at - 8 < hdr[1]) {
+                        missing++;
+                        break;
+                    }
+                    std::string path(r.data + at + 8, hdr[1]);
+                    at += 8 + hdr[1];
+                    auto c = path.empty() || path == top->get_full_name() ? comps.end() : comps.find(path);
+                    uvm_object* o = c != comps.end() ? c->second : top;
+                    int count = it->second->get_objection_count(o);
+                    int delta = int(hdr[0]) - count;
+                    if (delta > 0) {
+                        it->second->raise_objection(o, "checkpoint restore", delta);
+                        m_restore_raised.emplace_back(it->second, o, delta);
+                    } else if (delta < 0) {
+                        // the raises belong to live components, which drop them
+                        uvm_warning("UVM/CHECKPOINT", r.name + " is raised " + std::to_string(count) +
+                                    " times on " + o->get_full_name() + ", more than the " +
+                                    std::to_string(hdr[0]) + " in the checkpoint; left as is");
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        if (m_advance) m_advance(m_restored_time);
+        if (missing)
+            uvm_warning("UVM/CHECKPOINT", std::to_string(missing) + " checkpoint records had no match in this environment");
+        uvm_info("UVM/CHECKPOINT", "Restored checkpoint taken at end of " + m_restored_phase + " from " + file, UVM_LOW);
+        return true;
+    }
+
+    // Function: get_restored_phase
+    //
+    // The phase at whose end the restored checkpoint was taken.
+    const std::string& get_restored_phase() const { return m_restored_phase; }
+
+    // Function: get_restored_time
+    uint64_t get_restored_time() const { return m_restored_time; }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_CHECKPOINT_* plusargs. Idempotent.
+    void m_init() {
+        if (m_initialized) return;
+        m_initialized = true;
+        std::vector<std::string> args;
+        uvm_cmdline_processor::get_inst()->get_plusargs(args);
+        for (const std::string& a : args) {
+            if (a.compare(0, 21, "+UVM_CHECKPOINT_SAVE=") == 0) m_save_file = a.substr(21);
+            else if (a.compare(0, 24, "+UVM_CHECKPOINT_RESTORE=") == 0) m_restore_file = a.substr(24);
+            else if (a.compare(0, 22, "+UVM_CHECKPOINT_PHASE=") == 0) m_phase = a.substr(22);
+        }
+    }
+
+    // Function- m_phase_ended
+    //
+    // Called by <uvm_root::phase_ended> with the root as ~top~. Saves at the
+    // end of the checkpoint phase; restores at the end of pre_reset and jumps
+    // over the phases the checkpoint already covers.
+    void m_phase_ended(uvm_phase* phase, uvm_component* top) {
+        m_init();
+        std::string name = phase->get_name();
+        if (!m_save_file.empty() && name == m_phase) save(m_save_file, top, name);
+        if (m_restore_file.empty() || m_restore_done || name != "pre_reset") return;
+        m_restore_done = true;
+        if (!restore(m_restore_file, top)) return;
+        uvm_phase* saved = phase->find_by_name(m_restored_phase, false);
+        if (!saved || saved == phase) {
+            m_drop_restored();
+            return;
+        }
+        if (saved->m_successors.size() != 1) {
+            uvm_warning("UVM/CHECKPOINT", "Cannot resume after phase " + m_restored_phase + "; continuing from reset");
+            m_drop_restored();
+            return;
+        }
+        uvm_phase* target = saved->m_successors.begin()->first;
+        phase->jump(target);
+        if (m_restore_raised.empty()) return;
+        std::thread([this, target] {
+            target->wait_for_state(UVM_PHASE_STARTED, UVM_GTE);
+            m_drop_restored();
+        }).detach();
+    }
+
+private:
+    uvm_checkpoint() = default;
+
+    static void m_get_components(uvm_component* top, std::vector<uvm_component*>& comps) {
+        top->get_children(comps);
+        for (size_t i = 0; i < comps.size(); i++) comps[i]->get_children(comps);
+    }
+
+    std::vector<uvm_objection*> m_get_objections() {
+        std::vector<uvm_objection*> objs = m_objections;
+        uvm_objection* td = uvm_test_done_objection::get();
+        if (std::find(objs.begin(), objs.end(), td) == objs.end()) objs.insert(objs.begin(), td);
+        return objs;
+    }
+
+    // Drops what <restore> raised.
+    void m_drop_restored() {
+        for (auto& r : m_restore_raised)
+            std::get<0>(r)->drop_objection(std::get<1>(r), "checkpoint restore", std::get<2>(r));
+        m_restore_raised.clear();
+    }
+
+    // A checkpoint is applied only if the writer finished it.
+    static bool m_verify(const std::string& file) {
+        uvm_checkpoint_reader rd;
+        uvm_checkpoint_reader::record r;
+        if (!rd.open(file)) return false;
+        while (rd.next(r)) {}
+        return rd.is_complete();
+    }
+
+    std::map<std::string, uvm_bitmemory*> m_memories;
+    std::vector<uvm_objection*> m_objections;
+    std::vector<std::tuple<uvm_objection*, uvm_object*, int>> m_restore_raised;
+    std::function<uint64_t()> m_now;
+    std::function<void(uint64_t)> m_advance;
+
+    bool m_initialized = false;
+    bool m_restore_done = false;
+    std::string m_save_file;
+    std::string m_restore_file;
+    std::string m_phase = "post_configure";
+    std::string m_restored_phase;
+    uint64_t m_restored_time = 0;
+    int m_skipped = 0;
+};
+
+#endif // UVM_CHECKPOINT_H
@@ -11,6 +11,7 @@
 #include "base/uvm_factory.h"
 #include "base/uvm_report_object.h"
 #include "base/uvm_pool.h"
+#include "base/uvm_lazy.h"
 
 class uvm_domain;
 class uvm_objection;
@@ -868,6 +869,9 @@ public:
 
     bool print_enabled = true;
 
+    // Per-component containers below that most components never touch are
+    // <uvm_lazy_container> members, allocated on first insertion, so an idle
+    // leaf component stays small.
     int recording_depth;
     std::ofstream file;
     std::string filename = "tr_db.log";
@@ -878,15 +882,15 @@ public:
     bool identifier = true;
     uvm_recursion_policy_enum policy = UVM_DEFAULT_POLICY;
 
-    std::unordered_map<std::string, int> m_stream_handle;
-    std::unordered_map<uvm_transaction*, int> m_tr_h;
+    uvm_lazy_container<std::unordered_map<std::string, int>> m_stream_handle;
+    uvm_lazy_container<std::unordered_map<uvm_transaction*, int>> m_tr_h;
     std::string m_name;
 
     static const std::string type_name;
 
     uvm_recorder* recorder = nullptr;
 
-    std::vector<std::string> m_config_settings;
+    uvm_lazy_container<std::vector<std::string>> m_config_settings;
 
     //----------------------------------------------------------------------------
     //                     PRIVATE or PSUEDO-PRIVATE members
@@ -904,7 +908,7 @@ public:
     //----------------------------------------------------------------------------
 //protected:
     uvm_domain* m_domain = nullptr; // set_domain stores our domain handle
-    /*protected*/ std::unordered_map<uvm_phase*, uvm_phase*> m_phase_imps;  // Functors to override ovm_root defaults
+    /*protected*/ uvm_lazy_container<std::unordered_map<uvm_phase*, uvm_phase*>> m_phase_imps;  // Functors to override ovm_root defaults
 
     //TND review protected, provide read-only accessor.
     uvm_phase* m_current_phase = nullptr;
@@ -917,8 +921,9 @@ public:
 
     uvm_component* m_parent = nullptr;
 
-    std::unordered_map<std::string, uvm_component*> m_children;
-    std::unordered_map<uvm_component*, uvm_component*> m_children_by_handle;
+    // Leaves, the bulk of a large environment, never allocate these.
+    uvm_lazy_container<std::unordered_map<std::string, uvm_component*>> m_children;
+    uvm_lazy_container<std::unordered_map<uvm_component*, uvm_component*>> m_children_by_handle;
 
     virtual bool m_add_child(uvm_component* child);
     void m_set_full_name();
@@ -965,7 +970,7 @@ public:
         }
     };
 
-    std::vector<m_verbosity_setting> m_verbosity_settings;
+    uvm_lazy_container<std::vector<m_verbosity_setting>> m_verbosity_settings;
     static std::vector<m_verbosity_setting> m_time_settings;
 
     // does the pre abort callback hierarchically
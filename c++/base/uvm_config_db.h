@@ -56,7 +56,7 @@ class m_uvm_waiter {
 public:
     std::string inst_name;
     std::string field_name;
-    std::condition_variable trigger;
+    uvm_condition_variable trigger;
 
     m_uvm_waiter(const std::string& inst_name, const std::string& field_name)
         : inst_name(inst_name), field_name(field_name) {}
@@ -134,7 +134,7 @@ private:
     static uvm_resource<T>* m_get_resource_match(uvm_component* cntxt, const std::string& field_name, const std::string& scope);
     static std::unordered_map<uvm_component*, std::unordered_map<std::string, uvm_resource<T>*>> m_rsc;
     static std::unordered_map<std::string, std::list<m_uvm_waiter*>> m_waiters;
-    static std::mutex m_mtx;
+    static uvm_mutex m_mtx;
 };
 
 // Static member definitions
@@ -145,7 +145,7 @@ template <typename T>
 std::unordered_map<std::string, std::list<m_uvm_waiter*>> uvm_config_db<T>::m_waiters;
 
 template <typename T>
-std::mutex uvm_config_db<T>::m_mtx;
+uvm_mutex uvm_config_db<T>::m_mtx{"uvm_config_db::m_mtx"};
 
 // Function: get
 //
@@ -167,6 +167,9 @@ bool uvm_config_db<T>::get(uvm_component* cntxt, const std::string& inst_name, c
     std::vector<uvm_resource_base*> lookup_result;
     uvm_resource<T>* r = nullptr;
 
+    if (uvm_metrics::is_enabled())
+        uvm_framework_metrics::get()->config_lookups.inc();
+
     if (cntxt == nullptr) 
         cntxt = uvm_root::get();
     
@@ -270,6 +273,8 @@ void uvm_config_db<T>::set(uvm_component* cntxt, const std::string& inst_name, c
         uvm_resource_pool::get()->register_resource(escaped_key, r);
     } else {
         exists = true;
+        if (uvm_metrics::is_enabled())
+            uvm_framework_metrics::get()->config_overwrites.inc();
     }
 
     if (curr_phase != nullptr && curr_phase->get_name() == "build")
@@ -336,7 +341,7 @@ bool uvm_config_db<T>::exists(uvm_component* cntxt, const std::string& inst_name
 //| wait_config_modified_object(...) => uvm_config_db#(uvm_object)::wait_modified(cntxt,...)
 template <typename T>
 void uvm_config_db<T>::wait_modified(uvm_component* cntxt, const std::string& inst_name, const std::string& field_name) {
-    std::unique_lock<std::mutex> lk(m_mtx);
+    std::unique_lock<uvm_mutex> lk(m_mtx);
     std::string full_inst_name = cntxt->get_full_name();
     if (!inst_name.empty()) 
         full_inst_name += "." + inst_name;
@@ -29,6 +29,7 @@
 #include <mutex>
 #include <condition_variable>
 #include "base/uvm_object.h"
+#include "base/uvm_mutex.h"
 #include "base/uvm_event_callback.h"
 
 class uvm_printer;
@@ -201,8 +202,8 @@ private:
     std::vector<uvm_event_callback*> callbacks;
     
     // Synchronization primitives
-    mutable std::mutex mtx;
-    std::condition_variable cv;
+    mutable uvm_mutex mtx{"uvm_event"};
+    uvm_condition_variable cv;
 };
 
 #endif // UVM_EVENT_H
\ No newline at end of file
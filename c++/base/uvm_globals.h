@@ -41,6 +41,8 @@
 #include <condition_variable>
 
 #include "base/uvm_object_globals.h"
+#include "base/uvm_mutex.h"
+#include "base/uvm_metrics.h"
 
 #include "dpi/uvm_globals_dpi.h"
 
@@ -305,7 +307,7 @@ private:
     State currentState;
     std::atomic<bool> running;
     std::thread* processThread;
-    std::mutex stateMutex;
+    uvm_mutex stateMutex{"process"};
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -320,21 +322,24 @@ public:
     // Destructor
     ~mailbox() {
         running = false;
+        if (m_metered) uvm_framework_metrics::get()->mailbox_depth.sub(m_metered);
     }
 
     // Method to put data into the mailbox
     void put(const T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         cond.wait(lock, [this]() { return queue.size() < bound || bound == 0; });
         queue.push(data);
+        m_count_put();
         cond.notify_all();
     }
 
     // Method to try to put data into the mailbox
     bool try_put(const T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         if (queue.size() < bound || bound == 0) {
             queue.push(data);
+            m_count_put();
             cond.notify_all();
             return true;
         } else {
@@ -344,20 +349,22 @@ public:
 
     // Method to get data from the mailbox
     void get(T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         cond.wait(lock, [this]() { return !queue.empty() || !running; });
         if (!running && queue.empty()) return;
         data = queue.front();
         queue.pop();
+        m_count_get();
         cond.notify_all();
     }
 
     // Method to try to get data from the mailbox
     bool try_get(T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         if (!queue.empty()) {
             data = queue.front();
             queue.pop();
+            m_count_get();
             cond.notify_all();
             return true;
         } else {
@@ -367,7 +374,7 @@ public:
 
     // Method to peek data from the mailbox without removing it
     void peek(T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         cond.wait(lock, [this]() { return !queue.empty() || !running; });
         if (!running && queue.empty()) return;
         data = queue.front();
@@ -375,7 +382,7 @@ public:
 
     // Method to try to peek data from the mailbox without removing it
     bool try_peek(T& data) {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         if (!queue.empty()) {
             data = queue.front();
             return true;
@@ -386,16 +393,36 @@ public:
 
     // Method to get the number of entries in the mailbox
     int num() {
-        std::unique_lock<std::mutex> lock(mtx);
+        std::unique_lock<uvm_mutex> lock(mtx);
         return queue.size();
     }
 
 private:
+    // uvm.mailbox.depth/put_depth bookkeeping, see <uvm_framework_metrics>.
+    // Only items put while metrics are enabled are counted, so enabling them
+    // mid-run cannot drive the depth negative. Called with mtx held.
+    void m_count_put() {
+        if (!uvm_metrics::is_enabled()) return;
+        uvm_framework_metrics* fm = uvm_framework_metrics::get();
+        fm->mailbox_depth.add(1);
+        fm->mailbox_put_depth.record(queue.size());
+        m_metered++;
+    }
+
+    // Metered items are the newest, so the one just popped was metered only
+    // if every item that was queued is.
+    void m_count_get() {
+        if (m_metered == 0 || m_metered != queue.size() + 1) return;
+        m_metered--;
+        uvm_framework_metrics::get()->mailbox_depth.sub(1);
+    }
+
     std::queue<T> queue;
-    std::mutex mtx;
-    std::condition_variable cond;
+    uvm_mutex mtx{"mailbox"};
+    uvm_condition_variable cond;
     int bound;
     bool running;
+    size_t m_metered = 0;
 };
 
 
@@ -0,0 +1,149 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_HISTOGRAM_H
+#define UVM_HISTOGRAM_H
+
+#include <string>
+#include <atomic>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_log_histogram
+//
+// Lock-free histogram of non-negative 64-bit values with log-linear buckets,
+// in the manner of HDR histograms: each power of two is split into
+// 2^SUB_BITS linear sub-buckets, so every recorded value is known to within
+// 1/2^SUB_BITS of its magnitude (12.5% with the default of 3) over the whole
+// range. Values at or above 2^MAX_EXP land in the last bucket.
+//
+// <record> is a handful of relaxed atomic operations and may be called from
+// any number of threads; readers see a consistent-enough snapshot for
+// reporting.
+//------------------------------------------------------------------------------
+
+template <unsigned SUB_BITS = 3, unsigned MAX_EXP = 40>
+class uvm_log_histogram {
+public:
+    static const unsigned SUB = 1u << SUB_BITS;
+    static const unsigned NUM_BUCKETS = (MAX_EXP - SUB_BITS + 1) * SUB;
+
+    // Function: bucket_index
+    //
+    // Bucket of value ~v~.
+    static unsigned bucket_index(uint64_t v) {
+        if (v < SUB) return static_cast<unsigned>(v);
+        unsigned e = 63 - __builtin_clzll(v);
+        if (e >= MAX_EXP) return NUM_BUCKETS - 1;
+        unsigned shift = e - SUB_BITS;
+        return (shift + 1) * SUB + static_cast<unsigned>((v >> shift) - SUB);
+    }
+
+    // Function: bucket_low
+    //
+    // Smallest value that maps to bucket ~i~.
+    static uint64_t bucket_low(unsigned i) {
+        if (i < SUB) return i;
+        unsigned shift = i / SUB - 1;
+        return uint64_t(i % SUB + SUB) << shift;
+    }
+
+    void record(uint64_t v) {
+        m_buckets[bucket_index(v)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(v, std::memory_order_relaxed);
+        uint64_t mn = m_min.load(std::memory_order_relaxed);
+        while (v < mn && !m_min.compare_exchange_weak(mn, v, std::memory_order_relaxed)) {}
+        uint64_t mx = m_max.load(std::memory_order_relaxed);
+        while (v > mx && !m_max.compare_exchange_weak(mx, v, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t get_count() const { return m_count.load(std::memory_order_relaxed); }
+    uint64_t get_sum() const { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t get_min() const { return get_count() ? m_min.load(std::memory_order_relaxed) : 0; }
+    uint64_t get_max() const { return m_max.load(std::memory_order_relaxed); }
+    double get_mean() const { return get_count() ? double(get_sum()) / get_count() : 0; }
+    uint64_t get_bucket(unsigned i) const { return m_buckets[i].load(std::memory_order_relaxed); }
+
+    // Function: get_percentile
+    //
+    // Upper bound of the bucket holding the ~p~-th percentile (0-100),
+    // clamped to the recorded maximum.
+    uint64_t get_percentile(double p) const {
+        uint64_t n = get_count();
+        if (n == 0) return 0;
+        uint64_t rank = uint64_t(p / 100.0 * n + 0.5);
+        if (rank < 1) rank = 1;
+        uint64_t seen = 0;
+        for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+            seen += get_bucket(i);
+            if (seen >= rank) {
+                uint64_t hi = i + 1 < NUM_BUCKETS ? bucket_low(i + 1) - 1 : get_max();
+                return hi < get_max() ? hi : get_max();
+            }
+        }
+        return get_max();
+    }
+
+    // Function: merge
+    //
+    // Adds the contents of ~other~ to this histogram.
+    void merge(const uvm_log_histogram& other) {
+        if (other.get_count() == 0) return;
+        for (unsigned i = 0; i < NUM_BUCKETS; i++)
+            if (uint64_t n = other.get_bucket(i)) m_buckets[i].fetch_add(n, std::memory_order_relaxed);
+        m_count.fetch_add(other.get_count(), std::memory_order_relaxed);
+        m_sum.fetch_add(other.get_sum(), std::memory_order_relaxed);
+        uint64_t v = other.get_min(), mn = m_min.load(std::memory_order_relaxed);
+        while (v < mn && !m_min.compare_exchange_weak(mn, v, std::memory_order_relaxed)) {}
+        v = other.get_max();
+        uint64_t mx = m_max.load(std::memory_order_relaxed);
+        while (v > mx && !m_max.compare_exchange_weak(mx, v, std::memory_order_relaxed)) {}
+    }
+
+    void reset() {
+        for (auto& b : m_buckets) b.store(0, std::memory_order_relaxed);
+        m_count.store(0);
+        m_sum.store(0);
+        m_min.store(std::numeric_limits<uint64_t>::max());
+        m_max.store(0);
+    }
+
+    // Function: convert2string
+    //
+    // One-line summary; values are divided by ~scale~ (e.g. 1e3 for ns -> us).
+    std::string convert2string(double scale = 1.0, int precision = 3) const {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(precision) << "n=" << get_count() << " min=" << get_min() / scale
+           << " mean=" << get_mean() / scale << " p50=" << get_percentile(50) / scale
+           << " p99=" << get_percentile(99) / scale << " max=" << get_max() / scale;
+        return os.str();
+    }
+
+private:
+    std::atomic<uint64_t> m_buckets[NUM_BUCKETS] = {};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> m_max{0};
+};
+
+#endif // UVM_HISTOGRAM_H
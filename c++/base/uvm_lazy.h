@@ -0,0 +1,122 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_LAZY_H
+#define UVM_LAZY_H
+
+#include <memory>
+#include <utility>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_lazy_container
+//
+// A standard container member allocated on first insertion. It forwards the
+// usual container interface, so code written against the container (~m[k]~,
+// ~find~/~end~, range-for, ~push_back~, ~size~) compiles unchanged.
+// ~size~, ~empty~, ~count~, ~erase~ by key, ~clear~ and const access do not
+// allocate; const lookups and iteration on a container that was never
+// written read a shared empty instance. Non-const ~begin~, ~end~ and ~find~
+// allocate, since their iterators may be used to modify the container.
+//------------------------------------------------------------------------------
+
+template <typename C>
+class uvm_lazy_container {
+public:
+    typedef typename C::iterator iterator;
+    typedef typename C::const_iterator const_iterator;
+    typedef typename C::size_type size_type;
+    typedef typename C::value_type value_type;
+
+    uvm_lazy_container() = default;
+    uvm_lazy_container(const uvm_lazy_container&) = delete;
+    uvm_lazy_container& operator=(const uvm_lazy_container&) = delete;
+
+    // Function: get
+    //
+    // The container, allocated if needed.
+    C& get() {
+        if (!m_p) m_p.reset(new C());
+        return *m_p;
+    }
+
+    // Function: peek
+    //
+    // The container for reading: the shared empty one if never allocated.
+    const C& peek() const { return m_p ? *m_p : m_empty(); }
+
+    bool is_allocated() const { return m_p != nullptr; }
+
+    // Function: release
+    //
+    // Frees the storage; the container reads as empty again.
+    void release() { m_p.reset(); }
+
+    C* operator->() { return &get(); }
+    const C* operator->() const { return &peek(); }
+
+    // writing
+    template <typename K>
+    decltype(auto) operator[](K&& k) { return get()[std::forward<K>(k)]; }
+    template <typename... A>
+    decltype(auto) insert(A&&... a) { return get().insert(std::forward<A>(a)...); }
+    template <typename... A>
+    decltype(auto) emplace(A&&... a) { return get().emplace(std::forward<A>(a)...); }
+    template <typename V>
+    void push_back(V&& v) { get().push_back(std::forward<V>(v)); }
+    template <typename... A>
+    decltype(auto) emplace_back(A&&... a) { return get().emplace_back(std::forward<A>(a)...); }
+
+    iterator begin() { return get().begin(); }
+    iterator end() { return get().end(); }
+    const_iterator begin() const { return peek().begin(); }
+    const_iterator end() const { return peek().end(); }
+
+    template <typename K>
+    iterator find(const K& k) { return get().find(k); }
+    template <typename K>
+    const_iterator find(const K& k) const { return peek().find(k); }
+    template <typename K>
+    size_type count(const K& k) const { return m_p ? m_p->count(k) : 0; }
+
+    template <typename K, typename = std::enable_if_t<!std::is_convertible<const K&, const_iterator>::value>>
+    size_type erase(const K& k) { return m_p ? m_p->erase(k) : 0; }
+    iterator erase(const_iterator pos) { return get().erase(pos); }
+
+    size_type size() const { return m_p ? m_p->size() : 0; }
+    bool empty() const { return !m_p || m_p->empty(); }
+
+    void clear() {
+        if (m_p) m_p->clear();
+    }
+
+    template <typename K>
+    decltype(auto) at(const K& k) const { return peek().at(k); }
+    decltype(auto) back() { return get().back(); }
+    decltype(auto) front() { return get().front(); }
+
+private:
+    static const C& m_empty() {
+        static const C empty;
+        return empty;
+    }
+
+    std::unique_ptr<C> m_p;
+};
+
+#endif // UVM_LAZY_H
@@ -0,0 +1,576 @@
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _UVM_LOGICSTREAM_H_
+#define _UVM_LOGICSTREAM_H_
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+#include "base/uvm_bitstream.h"
+
+/**
+ * Four-state value of a single logic bit.
+ * The enumerator value is the (bval << 1 | aval) encoding used by SystemVerilog.
+ */
+enum uvm_logic_value {
+    UVM_LOGIC_0 = 0,
+    UVM_LOGIC_1 = 1,
+    UVM_LOGIC_Z = 2,
+    UVM_LOGIC_X = 3
+};
+
+/**
+ * One 32-bit slice of a four-state vector.
+ * The layout is identical to `svLogicVecVal` (aval first, then bval), so a DPI
+ * logic-vector buffer can be viewed as an array of `uvm_logic_word` directly.
+ * Per bit: 0 = (0,0), 1 = (1,0), Z = (0,1), X = (1,1).
+ */
+struct uvm_logic_word {
+    u32 aval;
+    u32 bval;
+};
+
+/**
+ * The `uvm_logicstream` class is the four-state (0/1/X/Z) companion of `uvm_bitstream`.
+ * Values are kept in the aval/bval plane layout of the DPI so that monitors can receive
+ * `svLogicVecVal` buffers without per-bit decoding. All bitwise operations work on whole
+ * words without branches, which lets the compiler vectorize the loops.
+ * A logicstream either owns its words or wraps an external DPI buffer (see `wrap`).
+ */
+class uvm_logicstream {
+
+    u32 lSize = 0;                    // Size of the logicstream in bits
+    u32 lWordCount = 0;               // Number of 32-bit aval/bval word pairs
+    uvm_logic_word* pWords = nullptr; // Pointer to the aval/bval word pairs
+    bool bOwner = true;               // `false` when the words belong to a wrapped DPI buffer
+
+    /**
+     * @returns The mask of the used bits of word `i`. Only the top word can be partial;
+     *          its unused bits are undefined in a wrapped DPI buffer.
+     */
+    u32 word_mask(u32 i) const {
+        return (i == lWordCount - 1 && (lSize & 31)) ? (1u << (lSize & 31)) - 1 : ~0u;
+    }
+
+    /**
+     * Masks off the bits above `lSize` in the top word.
+     */
+    void clip() {
+        if (lWordCount == 0 || (lSize & 31) == 0) return;
+        u32 m = word_mask(lWordCount - 1);
+        pWords[lWordCount - 1].aval &= m;
+        pWords[lWordCount - 1].bval &= m;
+    }
+
+    /**
+     * Releases the owned words, if any.
+     */
+    void release() {
+        if (bOwner) delete[] pWords;
+        pWords = nullptr;
+        lSize = lWordCount = 0;
+        bOwner = true;
+    }
+
+    /**
+     * Checks that two operands have the same width before a bitwise operation.
+     */
+    void check_width(const uvm_logicstream& rhs) const {
+        assert(lSize == rhs.lSize && "uvm_logicstream operands must have the same width");
+        (void)rhs;
+    }
+
+public:
+    // Constructors
+    /**
+     * Constructor that initializes a logicstream of the given width.
+     * @param lSizeAssign The size of the logicstream in bits.
+     * @param init The value every bit is initialized to (X by default, like an SV logic).
+     */
+    explicit uvm_logicstream(u32 lSizeAssign = 0, uvm_logic_value init = UVM_LOGIC_X) {
+        this->init(lSizeAssign, init);
+    }
+
+    /**
+     * Constructor that converts a two-state bitstream; the result has no X/Z bits.
+     * @param cbv The bitstream to convert from.
+     */
+    explicit uvm_logicstream(const uvm_bitstream& cbv) {
+        from_bitstream(cbv);
+    }
+
+    /**
+     * Copy constructor. The copy always owns its words, even if `cls` wraps a DPI buffer.
+     * @param cls The logicstream to copy from.
+     */
+    uvm_logicstream(const uvm_logicstream& cls) {
+        init(cls.lSize, UVM_LOGIC_0);
+        if (lWordCount) memcpy(pWords, cls.pWords, sizeof(*pWords) * lWordCount);
+        clip();
+    }
+
+    /**
+     * Move constructor. Takes over the words (or the wrapped buffer) of `cls`.
+     * @param cls The logicstream to move from.
+     */
+    uvm_logicstream(uvm_logicstream&& cls) noexcept
+        : lSize(cls.lSize), lWordCount(cls.lWordCount), pWords(cls.pWords), bOwner(cls.bOwner) {
+        cls.pWords = nullptr;
+        cls.lSize = cls.lWordCount = 0;
+        cls.bOwner = true;
+    }
+
+    // Destructor
+    /**
+     * Destructor that releases owned words. A wrapped DPI buffer is left untouched.
+     */
+    ~uvm_logicstream() { release(); }
+
+    /**
+     * Wraps a DPI logic-vector buffer without copying it.
+     * Writes through the returned logicstream go straight to the buffer, so it must not
+     * outlive the DPI call that provided the buffer. The unused bits of the top word
+     * need not be zero; compares, reductions and conversions ignore them.
+     * @param buf Pointer to the `svLogicVecVal` array (or any 8-byte aval/bval pair type).
+     * @param width The width of the SV logic vector in bits.
+     * @returns A non-owning logicstream viewing `buf`.
+     */
+    template <typename VecVal>
+    static uvm_logicstream wrap(VecVal* buf, u32 width) {
+        static_assert(sizeof(VecVal) == sizeof(uvm_logic_word) && std::is_standard_layout<VecVal>::value,
+                      "wrap expects an svLogicVecVal-compatible aval/bval pair type");
+        uvm_logicstream ls;
+        ls.lSize = width;
+        ls.lWordCount = (width + 31) / 32;
+        ls.pWords = reinterpret_cast<uvm_logic_word*>(buf);
+        ls.bOwner = false;
+        return ls;
+    }
+
+    // Initialization methods
+    /**
+     * (Re)initializes the logicstream with a new width and fill value.
+     * @param lSizeAssign The size of the logicstream in bits.
+     * @param init The value every bit is set to.
+     */
+    void init(u32 lSizeAssign, uvm_logic_value init = UVM_LOGIC_X) {
+        release();
+        lSize = lSizeAssign;
+        lWordCount = (lSizeAssign + 31) / 32;
+        if (lWordCount) pWords = new uvm_logic_word[lWordCount];
+        fill(init);
+    }
+
+    /**
+     * Sets every bit to the given value.
+     * @param v The value to fill with.
+     */
+    void fill(uvm_logic_value v) {
+        u32 a = (v & 1) ? ~0u : 0u;
+        u32 b = (v & 2) ? ~0u : 0u;
+        for (u32 i = 0; i < lWordCount; i++) {
+            pWords[i].aval = a;
+            pWords[i].bval = b;
+        }
+        clip();
+    }
+
+    // Assignment operators
+    /**
+     * Assignment operator. Widths must match when this logicstream wraps a DPI buffer,
+     * in which case the values are written into the buffer.
+     * @param cls The logicstream to assign from.
+     * @returns Reference to the current logicstream.
+     */
+    uvm_logicstream& operator=(const uvm_logicstream& cls) {
+        if (this == &cls) return *this;
+        if (bOwner && lSize != cls.lSize) init(cls.lSize, UVM_LOGIC_0);
+        check_width(cls);
+        if (lWordCount) memcpy(pWords, cls.pWords, sizeof(*pWords) * lWordCount);
+        clip();
+        return *this;
+    }
+
+    /**
+     * Move assignment operator.
+     * @param cls The logicstream to move from.
+     * @returns Reference to the current logicstream.
+     */
+    uvm_logicstream& operator=(uvm_logicstream&& cls) noexcept {
+        if (this == &cls) return *this;
+        release();
+        lSize = cls.lSize;
+        lWordCount = cls.lWordCount;
+        pWords = cls.pWords;
+        bOwner = cls.bOwner;
+        cls.pWords = nullptr;
+        cls.lSize = cls.lWordCount = 0;
+        cls.bOwner = true;
+        return *this;
+    }
+
+    // Conversion to and from uvm_bitstream
+    /**
+     * Loads a two-state bitstream; the width follows the bitstream and bval is cleared.
+     * @param cbv The bitstream to convert from.
+     */
+    void from_bitstream(const uvm_bitstream& cbv) {
+        if (bOwner && lSize != cbv.get_size()) init(cbv.get_size(), UVM_LOGIC_0);
+        assert(lSize == cbv.get_size());
+        const u32* src = cbv.get_words_ptr();
+        for (u32 i = 0; i < lWordCount; i++) {
+            pWords[i].aval = src[i];
+            pWords[i].bval = 0;
+        }
+        clip();
+    }
+
+    /**
+     * Converts to a two-state bitstream. X and Z bits become 0, as in an SV cast to bit.
+     * @param cbv The bitstream to store the result in.
+     * @returns `true` if the value had no X/Z bits, `false` otherwise.
+     */
+    bool to_bitstream(uvm_bitstream& cbv) const {
+        if (cbv.get_size() != lSize) cbv.init(lSize);
+        u32 unknown = 0;
+        for (u32 i = 0; i < lWordCount; i++) {
+            cbv.set_u_int32_t(i, pWords[i].aval & ~pWords[i].bval & word_mask(i));
+            unknown |= pWords[i].bval & word_mask(i);
+        }
+        return unknown == 0;
+    }
+
+    /**
+     * @returns The value plane as a bitstream (X/Z bits become 0).
+     */
+    uvm_bitstream to_bitstream() const {
+        uvm_bitstream cbv;
+        to_bitstream(cbv);
+        return cbv;
+    }
+
+    /**
+     * @returns A bitstream with 1 at every X or Z bit position.
+     */
+    uvm_bitstream get_unknown_mask() const {
+        uvm_bitstream cbv;
+        cbv.init(lSize);
+        for (u32 i = 0; i < lWordCount; i++) cbv.set_u_int32_t(i, pWords[i].bval & word_mask(i));
+        return cbv;
+    }
+
+    // Bit access
+    /**
+     * Retrieves the four-state value of a single bit.
+     * @param lBit The bit index to access.
+     * @returns The value of the bit.
+     */
+    uvm_logic_value get_bit(u32 lBit) const {
+        assert(lBit < lSize);
+        const uvm_logic_word& w = pWords[lBit >> 5];
+        u32 s = lBit & 31;
+        return static_cast<uvm_logic_value>(((w.aval >> s) & 1) | (((w.bval >> s) & 1) << 1));
+    }
+
+    /**
+     * Sets the four-state value of a single bit.
+     * @param lBit The bit index to set.
+     * @param v The value to set.
+     */
+    void set_bit(u32 lBit, uvm_logic_value v) {
+        assert(lBit < lSize);
+        uvm_logic_word& w = pWords[lBit >> 5];
+        u32 m = 1u << (lBit & 31);
+        w.aval = (v & 1) ? (w.aval | m) : (w.aval & ~m);
+        w.bval = (v & 2) ? (w.bval | m) : (w.bval & ~m);
+    }
+
+    /**
+     * Sets one aval/bval word pair.
+     * @param lSelect Index of the 32-bit word to set.
+     * @param aval The value plane.
+     * @param bval The unknown plane (default 0, i.e. two-state).
+     */
+    void set_word(u32 lSelect, u32 aval, u32 bval = 0) {
+        assert(lSelect < lWordCount);
+        pWords[lSelect].aval = aval;
+        pWords[lSelect].bval = bval;
+        if (lSelect == lWordCount - 1) clip();
+    }
+
+    /**
+     * @param lSelect Index of the 32-bit word to retrieve.
+     * @returns The aval/bval word pair.
+     */
+    uvm_logic_word get_word(u32 lSelect) const {
+        assert(lSelect < lWordCount);
+        return pWords[lSelect];
+    }
+
+    // Queries
+    /**
+     * @returns The size of the logicstream in bits.
+     */
+    u32 get_size() const { return lSize; }
+
+    /**
+     * @returns The number of aval/bval word pairs.
+     */
+    u32 get_word_size() const { return lWordCount; }
+
+    /**
+     * @returns A pointer to the aval/bval word pairs, layout-compatible with `svLogicVecVal`.
+     */
+    const uvm_logic_word* get_words_ptr() const { return pWords; }
+
+    /**
+     * @returns `false` if this logicstream wraps an external DPI buffer.
+     */
+    bool is_owner() const { return bOwner; }
+
+    /**
+     * @returns `true` if any bit is X or Z.
+     */
+    bool has_unknown() const {
+        u32 unknown = 0;
+        for (u32 i = 0; i < lWordCount; i++) unknown |= pWords[i].bval & word_mask(i);
+        return unknown != 0;
+    }
+
+    /**
+     * @returns The number of X bits.
+     */
+    u32 count_x() const {
+        u32 n = 0;
+        for (u32 i = 0; i < lWordCount; i++) n += uvm_bitstream::bit_cnt(pWords[i].aval & pWords[i].bval & word_mask(i));
+        return n;
+    }
+
+    /**
+     * @returns The number of Z bits.
+     */
+    u32 count_z() const {
+        u32 n = 0;
+        for (u32 i = 0; i < lWordCount; i++) n += uvm_bitstream::bit_cnt(~pWords[i].aval & pWords[i].bval & word_mask(i));
+        return n;
+    }
+
+    // Bitwise operators (IEEE 1800 four-state truth tables, Z treated as X)
+    /**
+     * Compound AND operator. 0 dominates, otherwise any X/Z yields X.
+     * @param cls The logicstream to AND with.
+     * @returns Reference to the current logicstream.
+     */
+    uvm_logicstream& operator&=(const uvm_logicstream& cls) {
+        check_width(cls);
+        uvm_logic_word* d = pWords;
+        const uvm_logic_word* s = cls.pWords;
+        for (u32 i = 0; i < lWordCount; i++) {
+            u32 zero = (~d[i].aval & ~d[i].bval) | (~s[i].aval & ~s[i].bval);
+            u32 x = (d[i].bval | s[i].bval) & ~zero;
+            d[i].aval = (d[i].aval & s[i].aval) & ~zero;
+            d[i].aval |= x;
+            d[i].bval = x;
+        }
+        return *this;
+    }
+
+    /**
+     * Compound OR operator. 1 dominates, otherwise any X/Z yields X.
+     * @param cls The logicstream to OR with.
+     * @returns Reference to the current logicstream.
+     */
+    uvm_logicstream& operator|=(const uvm_logicstream& cls) {
+        check_width(cls);
+        uvm_logic_word* d = pWords;
+        const uvm_logic_word* s = cls.pWords;
+        for (u32 i = 0; i < lWordCount; i++) {
+            u32 one = (d[i].aval & ~d[i].bval) | (s[i].aval & ~s[i].bval);
+            u32 x = (d[i].bval | s[i].bval) & ~one;
+            d[i].aval = one | x;
+            d[i].bval = x;
+        }
+        return *this;
+    }
+
+    /**
+     * Compound XOR operator. Any X/Z operand bit yields X.
+     * @param cls The logicstream to XOR with.
+     * @returns Reference to the current logicstream.
+     */
+    uvm_logicstream& operator^=(const uvm_logicstream& cls) {
+        check_width(cls);
+        uvm_logic_word* d = pWords;
+        const uvm_logic_word* s = cls.pWords;
+        for (u32 i = 0; i < lWordCount; i++) {
+            u32 x = d[i].bval | s[i].bval;
+            d[i].aval = (d[i].aval ^ s[i].aval) | x;
+            d[i].bval = x;
+        }
+        return *this;
+    }
+
+    /**
+     * Bitwise NOT operator. X and Z both yield X.
+     * @returns A new logicstream with the complemented bits.
+     */
+    uvm_logicstream operator~() const {
+        uvm_logicstream r(*this);
+        for (u32 i = 0; i < lWordCount; i++) r.pWords[i].aval = ~r.pWords[i].aval | r.pWords[i].bval;
+        r.clip();
+        return r;
+    }
+
+    // Comparison
+    /**
+     * Case equality (SV `===`): X and Z must match exactly.
+     * @param cls The logicstream to compare with.
+     * @returns `true` if both planes are identical.
+     */
+    bool case_equal(const uvm_logicstream& cls) const {
+        if (lSize != cls.lSize) return false;
+        if (lWordCount == 0) return true;
+        u32 last = lWordCount - 1;
+        if (last && memcmp(pWords, cls.pWords, sizeof(*pWords) * last) != 0) return false;
+        u32 m = word_mask(last);
+        return ((pWords[last].aval ^ cls.pWords[last].aval) & m) == 0 &&
+               ((pWords[last].bval ^ cls.pWords[last].bval) & m) == 0;
+    }
+
+    /**
+     * Logical equality (SV `==`) with X propagation.
+     * @param cls The logicstream to compare with.
+     * @returns UVM_LOGIC_0 if any known bit differs, UVM_LOGIC_X if the
+     *          result depends on an X/Z bit, UVM_LOGIC_1 otherwise.
+     */
+    uvm_logic_value logic_equal(const uvm_logicstream& cls) const {
+        check_width(cls);
+        u32 known_diff = 0;
+        u32 unknown = 0;
+        for (u32 i = 0; i < lWordCount; i++) {
+            u32 u = (pWords[i].bval | cls.pWords[i].bval) & word_mask(i);
+            known_diff |= (pWords[i].aval ^ cls.pWords[i].aval) & ~u & word_mask(i);
+            unknown |= u;
+        }
+        if (known_diff) return UVM_LOGIC_0;
+        return unknown ? UVM_LOGIC_X : UVM_LOGIC_1;
+    }
+
+    /**
+     * Wildcard equality (SV `==?`): X/Z bits of `pattern` are don't-care,
+     * X/Z bits of this value that are compared yield X.
+     * @param pattern The pattern to compare with.
+     * @returns The four-state compare result.
+     */
+    uvm_logic_value wildcard_equal(const uvm_logicstream& pattern) const {
+        check_width(pattern);
+        u32 known_diff = 0;
+        u32 unknown = 0;
+        for (u32 i = 0; i < lWordCount; i++) {
+            u32 care = ~pattern.pWords[i].bval & word_mask(i);
+            known_diff |= (pWords[i].aval ^ pattern.pWords[i].aval) & care & ~pWords[i].bval;
+            unknown |= pWords[i].bval & care;
+        }
+        if (known_diff) return UVM_LOGIC_0;
+        return unknown ? UVM_LOGIC_X : UVM_LOGIC_1;
+    }
+
+    // Display methods
+    /**
+     * Converts the logicstream to a binary string, MSB first, with x/z characters.
+     * @returns The binary string representation.
+     */
+    std::string convert2string() const {
+        static const char digits[4] = {'0', '1', 'z', 'x'};
+        std::string s(lSize, '0');
+        for (u32 i = 0; i < lSize; i++) s[lSize - 1 - i] = digits[get_bit(i)];
+        return s;
+    }
+
+    /**
+     * Converts the logicstream to a hexadecimal string, MSB first. A nibble that is
+     * entirely X (Z) prints as x (z); a partly unknown nibble prints as X (Z).
+     * @returns The hexadecimal string representation.
+     */
+    std::string convert2hex() const {
+        static const char hex[] = "0123456789abcdef";
+        u32 nibbles = (lSize + 3) / 4;
+        std::string s(nibbles, '0');
+        for (u32 n = 0; n < nibbles; n++) {
+            u32 w = n >> 3, sh = (n & 7) * 4;
+            u32 width = (n == nibbles - 1 && (lSize & 3)) ? (lSize & 3) : 4;
+            u32 m = (1u << width) - 1;
+            u32 a = (pWords[w].aval >> sh) & m;
+            u32 b = (pWords[w].bval >> sh) & m;
+            char c;
+            if (b == 0)           c = hex[a];
+            else if ((a & b) == b) c = (b == m) ? 'x' : 'X';
+            else if ((a & b) == 0) c = (b == m) ? 'z' : 'Z';
+            else                  c = 'X';
+            s[nibbles - 1 - n] = c;
+        }
+        return s;
+    }
+};
+
+/**
+ * Bitwise AND of two logicstreams.
+ */
+inline uvm_logicstream operator&(const uvm_logicstream& cls1, const uvm_logicstream& cls2) {
+    uvm_logicstream r(cls1);
+    r &= cls2;
+    return r;
+}
+
+/**
+ * Bitwise OR of two logicstreams.
+ */
+inline uvm_logicstream operator|(const uvm_logicstream& cls1, const uvm_logicstream& cls2) {
+    uvm_logicstream r(cls1);
+    r |= cls2;
+    return r;
+}
+
+/**
+ * Bitwise XOR of two logicstreams.
+ */
+inline uvm_logicstream operator^(const uvm_logicstream& cls1, const uvm_logicstream& cls2) {
+    uvm_logicstream r(cls1);
+    r ^= cls2;
+    return r;
+}
+
+/**
+ * Case equality (`===`) of two logicstreams.
+ */
+inline bool operator==(const uvm_logicstream& cls1, const uvm_logicstream& cls2) {
+    return cls1.case_equal(cls2);
+}
+
+/**
+ * Case inequality (`!==`) of two logicstreams.
+ */
+inline bool operator!=(const uvm_logicstream& cls1, const uvm_logicstream& cls2) {
+    return !cls1.case_equal(cls2);
+}
+
+inline std::ostream& operator<<(std::ostream& ios, const uvm_logicstream& cls) {
+    return ios << cls.convert2string();
+}
+
+#endif //_UVM_LOGICSTREAM_H_
@@ -0,0 +1,395 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_METRICS_H
+#define UVM_METRICS_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+#include "base/uvm_histogram.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_metric
+//
+// Base of the metrics held by <uvm_metrics>. A metric has a dotted name and
+// writes itself as one or more snapshot lines.
+//------------------------------------------------------------------------------
+
+class uvm_metric {
+public:
+    enum kind_e { COUNTER, GAUGE, HISTOGRAM };
+
+    uvm_metric(const std::string& name, kind_e kind) : m_name(name), m_kind(kind) {}
+    virtual ~uvm_metric() = default;
+
+    const std::string& get_name() const { return m_name; }
+    kind_e get_kind() const { return m_kind; }
+
+    // Function: m_write
+    //
+    // Appends this metric's snapshot lines, stamped ~ts_ms~, to ~os~.
+    virtual void m_write(std::ostream& os, int64_t ts_ms) const = 0;
+
+    virtual void reset() = 0;
+
+protected:
+    static const unsigned NUM_SHARDS = 16;
+
+    // Per-thread shard index, shared by every metric.
+    static unsigned m_shard() {
+        static std::atomic<unsigned> next{0};
+        static thread_local unsigned idx = next.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+        return idx;
+    }
+
+    void m_line(std::ostream& os, int64_t ts_ms, const char* suffix, int64_t value) const {
+        os << ts_ms << ' ' << m_name << suffix << ' ' << value << '\n';
+    }
+
+private:
+    std::string m_name;
+    kind_e m_kind;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_counter
+//
+// Monotonic count, kept in per-thread shards (one cache line each) and
+// summed on read.
+//------------------------------------------------------------------------------
+
+class uvm_counter : public uvm_metric {
+public:
+    explicit uvm_counter(const std::string& name) : uvm_metric(name, COUNTER) {}
+
+    void inc(uint64_t n = 1) { m_shards[m_shard()].v.fetch_add(n, std::memory_order_relaxed); }
+
+    uint64_t get() const {
+        uint64_t n = 0;
+        for (const shard& s : m_shards) n += s.v.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    void m_write(std::ostream& os, int64_t ts_ms) const override { m_line(os, ts_ms, "", get()); }
+
+    void reset() override {
+        for (shard& s : m_shards) s.v.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) shard { std::atomic<uint64_t> v{0}; };
+    shard m_shards[NUM_SHARDS];
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_gauge
+//
+// Current level of something (a queue depth, a pool size). It is a single
+// atomic rather than sharded, since <set> must replace the value exactly.
+// The highest value seen since the last <reset> is kept alongside.
+//------------------------------------------------------------------------------
+
+class uvm_gauge : public uvm_metric {
+public:
+    explicit uvm_gauge(const std::string& name) : uvm_metric(name, GAUGE) {}
+
+    void set(int64_t v) {
+        m_value.store(v, std::memory_order_relaxed);
+        m_peak(v);
+    }
+
+    void add(int64_t n) { m_peak(m_value.fetch_add(n, std::memory_order_relaxed) + n); }
+    void sub(int64_t n) { m_value.fetch_sub(n, std::memory_order_relaxed); }
+
+    int64_t get() const { return m_value.load(std::memory_order_relaxed); }
+    int64_t get_max() const { return m_max.load(std::memory_order_relaxed); }
+
+    void m_write(std::ostream& os, int64_t ts_ms) const override {
+        m_line(os, ts_ms, "", get());
+        m_line(os, ts_ms, ".max", get_max());
+    }
+
+    void reset() override { m_max.store(get(), std::memory_order_relaxed); }
+
+private:
+    void m_peak(int64_t v) {
+        int64_t mx = m_max.load(std::memory_order_relaxed);
+        while (v > mx && !m_max.compare_exchange_weak(mx, v, std::memory_order_relaxed)) {}
+    }
+
+    std::atomic<int64_t> m_value{0};
+    std::atomic<int64_t> m_max{0};
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_metric_histogram
+//
+// Distribution of non-negative values, one <uvm_log_histogram> per shard,
+// merged when read.
+//------------------------------------------------------------------------------
+
+class uvm_metric_histogram : public uvm_metric {
+public:
+    typedef uvm_log_histogram<> histogram;
+
+    explicit uvm_metric_histogram(const std::string& name) : uvm_metric(name, HISTOGRAM) {}
+
+    void record(uint64_t v) { m_shards[m_shard()].h.record(v); }
+
+    // Function: get
+    //
+    // The merge of all shards.
+    void get(histogram& merged) const {
+        for (const shard& s : m_shards) merged.merge(s.h);
+    }
+
+    void m_write(std::ostream& os, int64_t ts_ms) const override {
+        histogram h;
+        get(h);
+        m_line(os, ts_ms, ".count", h.get_count());
+        m_line(os, ts_ms, ".sum", h.get_sum());
+        m_line(os, ts_ms, ".p50", h.get_percentile(50));
+        m_line(os, ts_ms, ".p99", h.get_percentile(99));
+        m_line(os, ts_ms, ".max", h.get_max());
+    }
+
+    void reset() override {
+        for (shard& s : m_shards) s.h.reset();
+    }
+
+private:
+    struct alignas(64) shard { histogram h; };
+    shard m_shards[NUM_SHARDS];
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_metrics
+//
+// Registry of named <uvm_counter>, <uvm_gauge> and <uvm_metric_histogram>
+// instances, with an optional background thread that appends a snapshot of
+// every metric to a file at a fixed period:
+//
+//| +UVM_METRICS[=<file>]          enable, snapshot to <file> (uvm_metrics.txt)
+//| +UVM_METRICS_PERIOD=<ms>       snapshot period, default 1000
+//
+// Each snapshot is a block of lines of the form
+//
+//| <unix time ms> <metric name> <value>
+//
+// which a dashboard can tail. Counters are cumulative; histograms expand to
+// ~.count~, ~.sum~, ~.p50~, ~.p99~ and ~.max~ lines and gauges to the value
+// and its ~.max~.
+//
+// The framework's own metrics are in <uvm_framework_metrics>; they are only
+// updated while <is_enabled>, so a run without ~+UVM_METRICS~ pays one
+// relaxed load per instrumented call.
+//------------------------------------------------------------------------------
+
+class uvm_metrics {
+public:
+    static uvm_metrics* get() {
+        static uvm_metrics inst;
+        return &inst;
+    }
+
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+
+    // Function: counter
+    //
+    // Returns the counter ~name~, creating it on first use. The returned
+    // reference stays valid for the life of the program.
+    uvm_counter& counter(const std::string& name) { return m_get<uvm_counter>(name, uvm_metric::COUNTER); }
+
+    // Function: gauge
+    uvm_gauge& gauge(const std::string& name) { return m_get<uvm_gauge>(name, uvm_metric::GAUGE); }
+
+    // Function: histogram
+    uvm_metric_histogram& histogram(const std::string& name) {
+        return m_get<uvm_metric_histogram>(name, uvm_metric::HISTOGRAM);
+    }
+
+    std::vector<uvm_metric*> get_all() const {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_metrics;
+    }
+
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Function: snapshot
+    //
+    // Writes one line block for every registered metric, sorted by name.
+    void snapshot(std::ostream& os) const {
+        std::vector<uvm_metric*> v = get_all();
+        std::sort(v.begin(), v.end(), [](uvm_metric* a, uvm_metric* b) { return a->get_name() < b->get_name(); });
+        int64_t ts = now_ms();
+        for (const uvm_metric* m : v) m->m_write(os, ts);
+    }
+
+    std::string convert2string() const {
+        std::ostringstream os;
+        snapshot(os);
+        return os.str();
+    }
+
+    // Function: start_snapshotter
+    //
+    // Starts a background thread that appends a <snapshot> to ~file~ every
+    // ~period_ms~. A last snapshot is written when it is stopped.
+    bool start_snapshotter(const std::string& file, unsigned period_ms) {
+        stop_snapshotter();
+        m_out.open(file, std::ios::out | std::ios::app);
+        if (!m_out) return false;
+        m_stop = false;
+        m_snapshotter = std::thread([this, period_ms] {
+            std::unique_lock<std::mutex> lk(m_snap_mtx);
+            while (!m_snap_cv.wait_for(lk, std::chrono::milliseconds(period_ms), [this] { return m_stop; })) {
+                snapshot(m_out);
+                m_out.flush();
+            }
+        });
+        return true;
+    }
+
+    void stop_snapshotter() {
+        if (!m_snapshotter.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lk(m_snap_mtx);
+            m_stop = true;
+        }
+        m_snap_cv.notify_all();
+        m_snapshotter.join();
+        snapshot(m_out);
+        m_out.close();
+    }
+
+    // Function: m_init
+    //
+    // Applies the +UVM_METRICS* plusargs; called by <uvm_root::phase_ended>
+    // with the command line plusargs when build ends, so the framework
+    // metrics cover the phases from connect on.
+    void m_init(const std::vector<std::string>& plusargs);
+
+    ~uvm_metrics() { stop_snapshotter(); }
+
+private:
+    uvm_metrics() = default;
+
+    template <typename M>
+    M& m_get(const std::string& name, uvm_metric::kind_e kind) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        for (uvm_metric* m : m_metrics)
+            if (m->get_name() == name && m->get_kind() == kind) return *static_cast<M*>(m);
+        m_metrics.push_back(new M(name));
+        return *static_cast<M*>(m_metrics.back());
+    }
+
+    static inline std::atomic<bool> m_enabled{false};
+
+    mutable std::mutex m_mtx;
+    // never freed: references handed out by counter()/gauge()/histogram()
+    // are held in statics that may be used during static destruction
+    std::vector<uvm_metric*> m_metrics;
+
+    std::thread m_snapshotter;
+    std::mutex m_snap_mtx;
+    std::condition_variable m_snap_cv;
+    bool m_stop = false;
+    std::ofstream m_out;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_framework_metrics
+//
+// The metrics fed by the framework itself, registered up front so that every
+// snapshot has the same lines:
+//
+//| uvm.config.lookups       uvm_config_db::get calls
+//| uvm.config.overwrites    uvm_config_db::set calls that updated a resource
+//|                          already in the per-context table
+//| uvm.config.regex_evals   scope/name pattern matches evaluated by lookups
+//| uvm.factory.creations    objects and components created through a registry
+//| uvm.mailbox.depth        items queued across all mailboxes
+//| uvm.mailbox.put_depth    mailbox depth seen by each put (histogram)
+//| uvm.bitmemory.rows       rows uvm_bitmemory adopted from packets
+//
+// Call sites guard with <uvm_metrics::is_enabled>.
+//------------------------------------------------------------------------------
+
+struct uvm_framework_metrics {
+    uvm_counter& config_lookups;
+    uvm_counter& config_overwrites;
+    uvm_counter& config_regex_evals;
+    uvm_counter& factory_creations;
+    uvm_gauge& mailbox_depth;
+    uvm_metric_histogram& mailbox_put_depth;
+    uvm_counter& bitmemory_rows;
+
+    static uvm_framework_metrics* get() {
+        static uvm_framework_metrics inst(uvm_metrics::get());
+        return &inst;
+    }
+
+private:
+    explicit uvm_framework_metrics(uvm_metrics* m)
+        : config_lookups(m->counter("uvm.config.lookups")),
+          config_overwrites(m->counter("uvm.config.overwrites")),
+          config_regex_evals(m->counter("uvm.config.regex_evals")),
+          factory_creations(m->counter("uvm.factory.creations")),
+          mailbox_depth(m->gauge("uvm.mailbox.depth")),
+          mailbox_put_depth(m->histogram("uvm.mailbox.put_depth")),
+          bitmemory_rows(m->counter("uvm.bitmemory.rows")) {}
+};
+
+inline void uvm_metrics::m_init(const std::vector<std::string>& plusargs) {
+    std::string file;
+    unsigned period_ms = 1000;
+    for (const std::string& a : plusargs) {
+        if (a == "+UVM_METRICS") {
+            file = "uvm_metrics.txt";
+        } else if (a.compare(0, 13, "+UVM_METRICS=") == 0) {
+            file = a.substr(13);
+        } else if (a.compare(0, 20, "+UVM_METRICS_PERIOD=") == 0) {
+            period_ms = std::max(1, std::atoi(a.c_str() + 20));
+        }
+    }
+    if (file.empty()) return;
+    set_enabled(true);
+    uvm_framework_metrics::get();
+    start_snapshotter(file, period_ms);
+}
+
+#endif // UVM_METRICS_H
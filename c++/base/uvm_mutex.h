@@ -0,0 +1,347 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_MUTEX_H
+#define UVM_MUTEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_lock_stats
+//
+// Counters of one <uvm_mutex>, allocated on its first acquisition while
+// lock profiling is enabled (see <uvm_lock_registry::set_enabled>).
+//------------------------------------------------------------------------------
+
+struct uvm_lock_stats {
+    std::string name;
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contended{0};
+    std::atomic<uint64_t> wait_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+    std::atomic<uint64_t> hold_ns{0};
+    uint64_t instances = 1;
+
+    void merge(const uvm_lock_stats& o) {
+        acquisitions += o.acquisitions.load();
+        contended += o.contended.load();
+        wait_ns += o.wait_ns.load();
+        hold_ns += o.hold_ns.load();
+        max_wait_ns = std::max(max_wait_ns.load(), o.max_wait_ns.load());
+        instances += o.instances;
+    }
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_lock_registry
+//
+// Tracks the stats of every profiled <uvm_mutex>. When an instance is destroyed
+// its counts are folded into a retired entry of the same name, so short-lived
+// locks (one per mailbox, per event) do not grow the registry.
+//
+// <uvm_root> applies the plusargs when build ends and prints
+// <convert2string> from its report_phase:
+//
+//| +UVM_LOCK_PROFILE               enable lock profiling
+//| +UVM_LOCK_PROFILE_TOP=<n>       rows of the report (default 20)
+//------------------------------------------------------------------------------
+
+class uvm_lock_registry {
+public:
+    static uvm_lock_registry* get() {
+        static uvm_lock_registry* inst = new uvm_lock_registry();  // outlives static mutexes
+        return inst;
+    }
+
+    // Function: set_enabled
+    //
+    // Turns lock profiling on or off for every <uvm_mutex>. A lock starts
+    // being counted from its first acquisition after profiling is enabled.
+    static void set_enabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_LOCK_PROFILE* entries of ~args~. Called by
+    // <uvm_root::phase_ended> when build ends.
+    void m_init(const std::vector<std::string>& args) {
+        for (const std::string& a : args) {
+            if (a == "+UVM_LOCK_PROFILE")
+                set_enabled(true);
+            else if (a.compare(0, 22, "+UVM_LOCK_PROFILE_TOP=") == 0)
+                m_top_n = std::strtoul(a.c_str() + 22, nullptr, 10);
+        }
+    }
+
+    void add(uvm_lock_stats* s) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_live.push_back(s);
+    }
+
+    void remove(uvm_lock_stats* s) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_live.erase(std::find(m_live.begin(), m_live.end(), s));
+        auto it = m_retired.find(s->name);
+        if (it == m_retired.end()) {
+            it = m_retired.emplace(s->name, new uvm_lock_stats()).first;
+            it->second->name = s->name;
+            it->second->instances = 0;
+        }
+        it->second->merge(*s);
+    }
+
+    // Function: convert2string
+    //
+    // The ~top_n~ locks by total wait time (by default the
+    // ~+UVM_LOCK_PROFILE_TOP~ count, 20 if not given; 0 lists every lock).
+    // Live instances of the same name are listed separately; destroyed ones
+    // are summed per name.
+    std::string convert2string(size_t top_n = size_t(-1)) {
+        if (top_n == size_t(-1)) top_n = m_top_n;
+        struct row { std::string name; uint64_t inst, acq, cont, wait, maxw, hold; };
+        std::vector<row> rows;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            auto add = [&](const uvm_lock_stats* s) {
+                if (s->acquisitions.load() == 0) return;
+                rows.push_back({s->name, s->instances, s->acquisitions.load(), s->contended.load(),
+                                s->wait_ns.load(), s->max_wait_ns.load(), s->hold_ns.load()});
+            };
+            for (const uvm_lock_stats* s : m_live) add(s);
+            for (const auto& e : m_retired) add(e.second);
+        }
+        std::sort(rows.begin(), rows.end(), [](const row& a, const row& b) { return a.wait > b.wait; });
+        if (top_n && rows.size() > top_n) rows.resize(top_n);
+        std::ostringstream os;
+        os << "\n--- UVM lock contention (top " << top_n << " by wait time) ---\n";
+        os << std::left << std::setw(12) << "acquired" << std::setw(12) << "contended" << std::setw(12) << "wait(ms)"
+           << std::setw(14) << "max wait(us)" << std::setw(12) << "hold(ms)" << std::setw(7) << "inst" << "lock\n";
+        os << std::fixed << std::setprecision(3);
+        for (const row& r : rows)
+            os << std::left << std::setw(12) << r.acq << std::setw(12) << r.cont << std::setw(12) << r.wait / 1e6
+               << std::setw(14) << r.maxw / 1e3 << std::setw(12) << r.hold / 1e6 << std::setw(7) << r.inst
+               << r.name << "\n";
+        return os.str();
+    }
+
+private:
+    uvm_lock_registry() = default;
+
+    static inline std::atomic<bool> m_enabled{false};
+
+    std::mutex m_mtx;
+    std::vector<uvm_lock_stats*> m_live;
+    std::map<std::string, uvm_lock_stats*> m_retired;
+    size_t m_top_n = 20;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_mutex
+//
+// Named mutex used by the framework's synchronization primitives (uvm_event,
+// mailbox, process, uvm_phase, uvm_config_db). It wraps a std::mutex and
+// meets the Lockable requirements, so std::lock_guard<uvm_mutex> and
+// std::unique_lock<uvm_mutex> work as usual. It also converts to the
+// wrapped std::mutex (<native>), so the out-of-line sites that still lock
+// these members through std::lock_guard<std::mutex> keep compiling; those
+// acquisitions are not profiled.
+//
+// While <uvm_lock_registry::set_enabled> is on, every instance records
+// acquisitions, contended acquisitions, time spent waiting for the lock and
+// time it was held, and <uvm_lock_registry::convert2string> reports the
+// hottest locks. While it is off, lock() costs one relaxed load on top of
+// the std::mutex. Profiling is a run-time switch so that the class has one
+// layout and one definition in every translation unit.
+//------------------------------------------------------------------------------
+
+class uvm_mutex {
+public:
+    explicit uvm_mutex(const char* name = "uvm_mutex") : m_name(name ? name : "uvm_mutex") {}
+
+    ~uvm_mutex() {
+        if (uvm_lock_stats* s = m_stats.load(std::memory_order_acquire)) {
+            uvm_lock_registry::get()->remove(s);
+            delete s;
+        }
+    }
+
+    uvm_mutex(const uvm_mutex&) = delete;
+    uvm_mutex& operator=(const uvm_mutex&) = delete;
+
+    void lock() {
+        if (!uvm_lock_registry::is_enabled()) {
+            m_mtx.lock();
+            return;
+        }
+        if (m_mtx.try_lock()) {
+            m_acquired();
+            return;
+        }
+        int64_t t0 = m_now();
+        m_mtx.lock();
+        uint64_t w = m_now() - t0;
+        uvm_lock_stats* s = m_get_stats();
+        s->contended.fetch_add(1, std::memory_order_relaxed);
+        s->wait_ns.fetch_add(w, std::memory_order_relaxed);
+        uint64_t mx = s->max_wait_ns.load(std::memory_order_relaxed);
+        while (w > mx && !s->max_wait_ns.compare_exchange_weak(mx, w, std::memory_order_relaxed)) {}
+        m_acquired();
+    }
+
+    bool try_lock() {
+        if (!m_mtx.try_lock()) return false;
+        if (uvm_lock_registry::is_enabled()) m_acquired();
+        return true;
+    }
+
+    void unlock() {
+        m_released();
+        m_mtx.unlock();
+    }
+
+    // The wrapped mutex. Locking it directly, or through the conversion,
+    // bypasses lock() and unlock(), so those acquisitions are not profiled.
+    std::mutex& native() { return m_mtx; }
+    operator std::mutex&() { return m_mtx; }
+
+    // Null until the lock has been taken with profiling enabled.
+    const uvm_lock_stats* get_stats() const { return m_stats.load(std::memory_order_acquire); }
+
+    // Hold-time bookkeeping around a condition variable wait, which releases
+    // and reacquires the native mutex behind our back.
+    void m_released() {
+        if (m_locked_at == 0) return;
+        m_stats.load(std::memory_order_relaxed)->hold_ns.fetch_add(m_now() - m_locked_at, std::memory_order_relaxed);
+        m_locked_at = 0;
+    }
+
+    void m_reacquired() {
+        if (!uvm_lock_registry::is_enabled()) return;
+        m_get_stats();
+        m_locked_at = m_now();
+    }
+
+private:
+    static int64_t m_now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Called with m_mtx held, so only one thread allocates.
+    uvm_lock_stats* m_get_stats() {
+        uvm_lock_stats* s = m_stats.load(std::memory_order_relaxed);
+        if (!s) {
+            s = new uvm_lock_stats();
+            s->name = m_name;
+            uvm_lock_registry::get()->add(s);
+            m_stats.store(s, std::memory_order_release);
+        }
+        return s;
+    }
+
+    void m_acquired() {
+        m_get_stats()->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        m_locked_at = m_now();
+    }
+
+    std::mutex m_mtx;
+    const char* m_name;
+    std::atomic<uvm_lock_stats*> m_stats{nullptr};
+    int64_t m_locked_at = 0;   // written only by the owner; 0 when not timed
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_condition_variable
+//
+// std::condition_variable that waits on a std::unique_lock<uvm_mutex>,
+// keeping the <uvm_mutex> hold-time accounting correct across the wait.
+// The std::unique_lock<std::mutex> overloads are kept for existing sites.
+//------------------------------------------------------------------------------
+
+class uvm_condition_variable {
+public:
+    void notify_one() noexcept { m_cv.notify_one(); }
+    void notify_all() noexcept { m_cv.notify_all(); }
+
+    void wait(std::unique_lock<uvm_mutex>& lk) {
+        uvm_mutex* m = lk.mutex();
+        m->m_released();
+        std::unique_lock<std::mutex> native(m->native(), std::adopt_lock);
+        m_cv.wait(native);
+        native.release();
+        m->m_reacquired();
+    }
+
+    template <typename Pred>
+    void wait(std::unique_lock<uvm_mutex>& lk, Pred pred) {
+        while (!pred()) wait(lk);
+    }
+
+    template <typename Rep, typename Period>
+    std::cv_status wait_for(std::unique_lock<uvm_mutex>& lk, const std::chrono::duration<Rep, Period>& d) {
+        uvm_mutex* m = lk.mutex();
+        m->m_released();
+        std::unique_lock<std::mutex> native(m->native(), std::adopt_lock);
+        std::cv_status st = m_cv.wait_for(native, d);
+        native.release();
+        m->m_reacquired();
+        return st;
+    }
+
+    template <typename Rep, typename Period, typename Pred>
+    bool wait_for(std::unique_lock<uvm_mutex>& lk, const std::chrono::duration<Rep, Period>& d, Pred pred) {
+        auto deadline = std::chrono::steady_clock::now() + d;
+        while (!pred())
+            if (wait_for(lk, deadline - std::chrono::steady_clock::now()) == std::cv_status::timeout) return pred();
+        return true;
+    }
+
+    void wait(std::unique_lock<std::mutex>& lk) { m_cv.wait(lk); }
+
+    template <typename Pred>
+    void wait(std::unique_lock<std::mutex>& lk, Pred pred) { m_cv.wait(lk, pred); }
+
+    template <typename Rep, typename Period>
+    std::cv_status wait_for(std::unique_lock<std::mutex>& lk, const std::chrono::duration<Rep, Period>& d) {
+        return m_cv.wait_for(lk, d);
+    }
+
+    template <typename Rep, typename Period, typename Pred>
+    bool wait_for(std::unique_lock<std::mutex>& lk, const std::chrono::duration<Rep, Period>& d, Pred pred) {
+        return m_cv.wait_for(lk, d, pred);
+    }
+
+private:
+    std::condition_variable m_cv;
+};
+
+#endif // UVM_MUTEX_H
@@ -28,6 +28,7 @@
 
 #include "base/uvm_misc.h"
 #include "base/uvm_globals.h"
+#include "base/uvm_type_accounting.h"
 #include "macros/uvm_object_defines.h"
 
 //------------------------------------------------------------------------------
@@ -600,6 +601,8 @@ public:
     std::string m_leaf_name;
     int m_inst_id;
     static int m_inst_count;
+    // Per-type live accounting; attached by the object/component registries.
+    uvm_type_stats_handle m_type_stats;
 
     virtual uvm_report_object* m_get_report_object();
     virtual void __m_uvm_field_automation(uvm_object* tmp_data, int what, const std::string& str);
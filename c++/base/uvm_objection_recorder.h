@@ -0,0 +1,460 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_OBJECTION_RECORDER_H
+#define UVM_OBJECTION_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+#include "base/uvm_objection.h"
+#include "base/uvm_cmdline_processor.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_objection_recorder
+//
+// Binary recorder for objection activity. Each <UVM_OBJECTION_RECORD> probe
+// stores one raise, drop or all-dropped as a fixed-size event in a ring
+// buffer; once the ring is full the oldest events are overwritten. Recording
+// claims a slot with one atomic increment and performs no allocation.
+//
+// <uvm_root> records the activity that reaches the top of the hierarchy
+// from its raised, dropped and all_dropped callbacks (see <record_top>),
+// applies the plusargs when build ends and writes the dump from its
+// report_phase. Code that raises and drops can also place the probes for
+// intermediate levels after the count of ~obj~ has been updated.
+// <apply_plusargs> (or <enable>) turns recording on:
+//
+//| +UVM_OBJECTION_RECORD              enable, dump goes to uvm_objection_events.bin
+//| +UVM_OBJECTION_RECORD=<file>       enable, dump goes to <file>
+//| +UVM_OBJECTION_RECORD_SIZE=<n>     ring capacity in events (default 1M)
+//
+// Object names are not captured on the hot path; <write> resolves them once
+// when the dump is written, so objects must still be alive at that point
+// (normally the end of the test). The dump is read back by
+// <uvm_objection_analyzer>.
+//------------------------------------------------------------------------------
+
+class uvm_objection_recorder {
+public:
+
+    struct event {
+        int64_t time_ns;       // steady clock, relative to the recorder epoch
+        uint64_t objection;    // uvm_objection* (one per phase)
+        uint64_t obj;          // object whose count changed
+        uint64_t source;       // object that originated the raise/drop
+        int32_t delta;         // +count for raise, -count for drop, 0 otherwise
+        int32_t total;         // obj's total count after the change
+        uint8_t kind;          // uvm_objection_event
+        uint8_t top;           // obj is the top of the hierarchy
+        uint8_t pad[6];
+    };
+
+    static uvm_objection_recorder* get() {
+        static uvm_objection_recorder inst;
+        return &inst;
+    }
+
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Function: enable
+    //
+    // Allocates a ring of ~capacity~ events (rounded up to a power of two)
+    // and starts recording. Returns false, and changes nothing, while
+    // recording is on. The ring is allocated by the first call only and kept
+    // for the life of the recorder, since a probe that passed <is_enabled>
+    // before a <disable> may still be writing to it; later calls restart
+    // recording in the same ring and ignore ~capacity~.
+    bool enable(size_t capacity = size_t(1) << 20) {
+        if (is_enabled()) return false;
+        if (!m_ring) {
+            size_t n = 1;
+            while (n < capacity) n <<= 1;
+            m_ring.reset(new event[n]);
+            m_mask = n - 1;
+        }
+        m_head.store(0);
+        m_enabled.store(true);
+        return true;
+    }
+
+    void disable() { m_enabled.store(false); }
+
+    // Function: apply_plusargs
+    //
+    // Applies the +UVM_OBJECTION_RECORD* plusargs.
+    void apply_plusargs() {
+        std::vector<std::string> args;
+        uvm_cmdline_processor::get_inst()->get_plusargs(args);
+        m_init(args);
+    }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_OBJECTION_RECORD* entries of ~args~. Called by
+    // <uvm_root::phase_ended> when build ends.
+    void m_init(const std::vector<std::string>& args) {
+        size_t capacity = size_t(1) << 20;
+        bool on = false;
+        for (const std::string& a : args) {
+            if (a == "+UVM_OBJECTION_RECORD") {
+                on = true;
+            } else if (a.compare(0, 22, "+UVM_OBJECTION_RECORD=") == 0) {
+                on = true;
+                m_file = a.substr(22);
+            } else if (a.compare(0, 27, "+UVM_OBJECTION_RECORD_SIZE=") == 0) {
+                capacity = std::strtoull(a.c_str() + 27, nullptr, 0);
+            }
+        }
+        if (on) enable(capacity);
+    }
+
+    // Function: record
+    //
+    // Hot-path hook. ~total~ is the count of ~obj~ after the change.
+    void record(uvm_objection* objection, uvm_object* obj, uvm_object* source,
+                int delta, int total, uvm_objection_event kind, bool top) {
+        uint64_t i = m_head.fetch_add(1, std::memory_order_relaxed);
+        event& e = m_ring[i & m_mask];
+        e.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch).count();
+        e.objection = reinterpret_cast<uint64_t>(objection);
+        e.obj = reinterpret_cast<uint64_t>(obj);
+        e.source = reinterpret_cast<uint64_t>(source);
+        e.delta = delta;
+        e.total = total;
+        e.kind = static_cast<uint8_t>(kind);
+        e.top = top;
+    }
+
+    // Function: record_top
+    //
+    // Records a change of ~delta~ in the count of ~objection~ at ~top~, the
+    // top of the hierarchy. The top-level total is kept here, per objection,
+    // so the callbacks that report the change need not query the objection.
+    // Counts raised before recording was enabled are not known, so the total
+    // does not go below zero.
+    void record_top(uvm_objection* objection, uvm_object* top, uvm_object* source,
+                    int delta, uvm_objection_event kind) {
+        std::lock_guard<std::mutex> lock(m_top_mutex);
+        int& total = m_top_totals[objection];
+        total = std::max(0, total + delta);
+        record(objection, top, source, delta, total, kind, true);
+    }
+
+    // Function: get_events
+    //
+    // Returns the events still in the ring, oldest first. Not synchronized
+    // with concurrent recording.
+    std::vector<event> get_events() const {
+        std::vector<event> v;
+        if (!m_ring) return v;
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t first = head > m_mask + 1 ? head - (m_mask + 1) : 0;
+        v.reserve(head - first);
+        for (uint64_t i = first; i < head; i++) v.push_back(m_ring[i & m_mask]);
+        return v;
+    }
+
+    // Function: get_dropped_count
+    //
+    // Number of events lost to ring wrap-around.
+    uint64_t get_dropped_count() const {
+        uint64_t head = m_head.load();
+        return m_ring && head > m_mask + 1 ? head - (m_mask + 1) : 0;
+    }
+
+    // Function: write
+    //
+    // Writes the dump: a name table for every id referenced by the events
+    // followed by the raw events. Returns false on I/O failure.
+    //
+    //| "UVMOBJR1" u32 event_size u64 dropped
+    //| u64 name_count { u64 id, u32 len, char[len] }*
+    //| u64 event_count event*
+    bool write(const std::string& filename = "") const {
+        std::vector<event> ev = get_events();
+        std::map<uint64_t, std::string> names;
+        for (const event& e : ev) {
+            if (!names.count(e.objection))
+                names[e.objection] = reinterpret_cast<uvm_objection*>(e.objection)->get_name();
+            if (e.obj && !names.count(e.obj))
+                names[e.obj] = reinterpret_cast<uvm_object*>(e.obj)->get_full_name();
+            if (e.source && !names.count(e.source))
+                names[e.source] = reinterpret_cast<uvm_object*>(e.source)->get_full_name();
+        }
+        std::ofstream os(filename.empty() ? m_file : filename, std::ios::binary);
+        if (!os) return false;
+        uint32_t esz = sizeof(event);
+        uint64_t dropped = get_dropped_count(), n = names.size(), ne = ev.size();
+        os.write("UVMOBJR1", 8);
+        os.write(reinterpret_cast<const char*>(&esz), sizeof(esz));
+        os.write(reinterpret_cast<const char*>(&dropped), sizeof(dropped));
+        os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        for (const auto& e : names) {
+            uint32_t len = static_cast<uint32_t>(e.second.size());
+            os.write(reinterpret_cast<const char*>(&e.first), sizeof(e.first));
+            os.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            os.write(e.second.data(), len);
+        }
+        os.write(reinterpret_cast<const char*>(&ne), sizeof(ne));
+        os.write(reinterpret_cast<const char*>(ev.data()), ne * sizeof(event));
+        return bool(os);
+    }
+
+    std::string get_file() const { return m_file; }
+
+private:
+    uvm_objection_recorder() : m_epoch(std::chrono::steady_clock::now()) {}
+
+    static inline std::atomic<bool> m_enabled{false};
+
+    std::unique_ptr<event[]> m_ring;
+    uint64_t m_mask = 0;
+    std::atomic<uint64_t> m_head{0};
+    std::chrono::steady_clock::time_point m_epoch;
+    std::string m_file = "uvm_objection_events.bin";
+    std::mutex m_top_mutex;
+    std::unordered_map<uvm_objection*, int> m_top_totals;
+};
+
+#define UVM_OBJECTION_RECORD(OBJN, OBJ, SRC, DELTA, TOTAL, KIND, TOP) \
+    do { if (uvm_objection_recorder::is_enabled()) \
+        uvm_objection_recorder::get()->record(OBJN, OBJ, SRC, DELTA, TOTAL, KIND, TOP); } while (0)
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_objection_analyzer
+//
+// Offline analysis of a <uvm_objection_recorder> dump (or of the live ring).
+// Reports, per source object, how often it raised; per objection (that is,
+// per phase), how long the top level sat at zero waiting for the drain time
+// to expire; and the final dropper, the source that held the phase alive on
+// its own before the last drop.
+//------------------------------------------------------------------------------
+
+class uvm_objection_analyzer {
+public:
+
+    struct source_stat {
+        std::string name;
+        uint64_t raises = 0;
+        uint64_t drops = 0;
+        int64_t raised_count = 0;
+    };
+
+    struct phase_stat {
+        std::string name;
+        uint64_t events = 0;
+        int64_t first_ns = 0;
+        int64_t last_ns = 0;
+        int64_t drain_wait_ns = 0;      // top at zero until all_dropped
+        uint64_t drains_aborted = 0;    // re-raised while draining
+        std::string final_dropper;
+        int64_t held_alone_ns = 0;      // final dropper was the only source
+    };
+
+    // Function: load
+    //
+    // Reads a dump written by <uvm_objection_recorder::write>. Returns false,
+    // with nothing loaded, if the file is short, corrupt or not a dump; the
+    // counts in the file are checked against the bytes left before anything
+    // is allocated for them.
+    bool load(const std::string& filename) {
+        typedef uvm_objection_recorder::event event;
+        std::ifstream is(filename, std::ios::binary | std::ios::ate);
+        if (!is) return false;
+        uint64_t left = static_cast<uint64_t>(is.tellg());
+        is.seekg(0);
+        auto get = [&](void* p, uint64_t len) {
+            if (len > left || !is.read(static_cast<char*>(p), len)) return false;
+            left -= len;
+            return true;
+        };
+        char magic[8];
+        uint32_t esz = 0;
+        uint64_t dropped = 0, n = 0;
+        if (!get(magic, 8) || std::memcmp(magic, "UVMOBJR1", 8) != 0) return false;
+        if (!get(&esz, sizeof(esz)) || esz != sizeof(event)) return false;
+        if (!get(&dropped, sizeof(dropped)) || !get(&n, sizeof(n))) return false;
+        // Each name entry takes at least its id and length.
+        if (n > left / (sizeof(uint64_t) + sizeof(uint32_t))) return false;
+        std::unordered_map<uint64_t, std::string> names;
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t id;
+            uint32_t len;
+            if (!get(&id, sizeof(id)) || !get(&len, sizeof(len)) || len > left) return false;
+            std::string s(len, '\0');
+            if (!get(&s[0], len)) return false;
+            names[id] = std::move(s);
+        }
+        if (!get(&n, sizeof(n)) || n != left / sizeof(event) || left % sizeof(event)) return false;
+        std::vector<event> events(n);
+        if (!get(events.data(), n * sizeof(event))) return false;
+        m_dropped = dropped;
+        m_names = std::move(names);
+        m_events = std::move(events);
+        return true;
+    }
+
+    // Function: load_live
+    //
+    // Analyzes the recorder's ring in-process. Names are resolved on the fly.
+    void load_live(const uvm_objection_recorder* rec = uvm_objection_recorder::get()) {
+        m_events = rec->get_events();
+        m_dropped = rec->get_dropped_count();
+        m_names.clear();
+        for (const auto& e : m_events) {
+            m_names[e.objection] = reinterpret_cast<uvm_objection*>(e.objection)->get_name();
+            if (e.source) m_names[e.source] = reinterpret_cast<uvm_object*>(e.source)->get_full_name();
+        }
+    }
+
+    // Function: get_hot_sources
+    //
+    // Sources ordered by number of raises they originated.
+    std::vector<source_stat> get_hot_sources(size_t top_n = 0) const {
+        std::unordered_map<uint64_t, source_stat> m;
+        for (const auto& e : m_events) {
+            // count each raise/drop once, at the level it originated
+            if (e.obj != e.source || e.delta == 0) continue;
+            source_stat& s = m[e.source];
+            if (e.delta > 0) {
+                s.raises++;
+                s.raised_count += e.delta;
+            } else {
+                s.drops++;
+            }
+        }
+        std::vector<source_stat> v;
+        for (auto& e : m) {
+            e.second.name = m_name(e.first);
+            v.push_back(e.second);
+        }
+        std::sort(v.begin(), v.end(), [](const source_stat& a, const source_stat& b) { return a.raises > b.raises; });
+        if (top_n && v.size() > top_n) v.resize(top_n);
+        return v;
+    }
+
+    // Function: get_phase_stats
+    //
+    // One entry per objection, in order of first activity.
+    std::vector<phase_stat> get_phase_stats() const {
+        struct state {
+            phase_stat st;
+            std::unordered_map<uint64_t, int64_t> outstanding;  // per source, at the top
+            int64_t zero_since = -1;
+            int64_t sole_since = -1;
+            uint64_t last_dropper = 0;
+            int64_t last_alone = 0;
+        };
+        std::vector<uint64_t> order;
+        std::unordered_map<uint64_t, state> m;
+        for (const auto& e : m_events) {
+            auto it = m.find(e.objection);
+            if (it == m.end()) {
+                order.push_back(e.objection);
+                it = m.emplace(e.objection, state()).first;
+                it->second.st.name = m_name(e.objection);
+                it->second.st.first_ns = e.time_ns;
+            }
+            state& s = it->second;
+            s.st.events++;
+            s.st.last_ns = e.time_ns;
+            if (!e.top) continue;
+            if (e.kind == UVM_ALL_DROPPED) {
+                if (s.zero_since >= 0) s.st.drain_wait_ns += e.time_ns - s.zero_since;
+                s.zero_since = -1;
+                s.st.final_dropper = m_name(s.last_dropper);
+                s.st.held_alone_ns = s.last_alone;
+                continue;
+            }
+            if (e.delta > 0 && s.zero_since >= 0) {
+                s.st.drains_aborted++;
+                s.zero_since = -1;
+            }
+            int64_t& cnt = s.outstanding[e.source];
+            cnt += e.delta;
+            if (cnt <= 0) s.outstanding.erase(e.source);
+            if (s.outstanding.size() == 1) {
+                if (s.sole_since < 0) s.sole_since = e.time_ns;
+            } else if (!s.outstanding.empty()) {
+                s.sole_since = -1;
+            }
+            if (e.delta < 0 && e.total == 0) {
+                s.zero_since = e.time_ns;
+                s.last_dropper = e.source;
+                s.last_alone = s.sole_since >= 0 ? e.time_ns - s.sole_since : 0;
+                s.sole_since = -1;
+            }
+        }
+        std::vector<phase_stat> v;
+        for (uint64_t id : order) v.push_back(m[id].st);
+        return v;
+    }
+
+    // Function: convert2string
+    //
+    // Text report of the hot sources and per-phase drain statistics.
+    std::string convert2string(size_t top_n = 20) const {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3);
+        os << "--- Objection activity: " << m_events.size() << " events";
+        if (m_dropped) os << " (" << m_dropped << " lost to ring wrap)";
+        os << " ---\n\nTop raisers:\n";
+        os << std::left << std::setw(10) << "raises" << std::setw(10) << "drops" << "source\n";
+        for (const auto& s : get_hot_sources(top_n))
+            os << std::left << std::setw(10) << s.raises << std::setw(10) << s.drops << s.name << "\n";
+        os << "\nPhases:\n";
+        os << std::left << std::setw(24) << "objection" << std::setw(12) << "span(ms)" << std::setw(12) << "drain(ms)"
+           << std::setw(9) << "aborted" << std::setw(12) << "alone(ms)" << "final dropper\n";
+        for (const auto& p : get_phase_stats())
+            os << std::left << std::setw(24) << p.name << std::setw(12) << (p.last_ns - p.first_ns) / 1e6
+               << std::setw(12) << p.drain_wait_ns / 1e6 << std::setw(9) << p.drains_aborted
+               << std::setw(12) << p.held_alone_ns / 1e6 << p.final_dropper << "\n";
+        return os.str();
+    }
+
+    const std::vector<uvm_objection_recorder::event>& get_events() const { return m_events; }
+
+private:
+    std::string m_name(uint64_t id) const {
+        auto it = m_names.find(id);
+        if (it != m_names.end()) return it->second;
+        std::ostringstream os;
+        os << "0x" << std::hex << id;
+        return os.str();
+    }
+
+    std::vector<uvm_objection_recorder::event> m_events;
+    std::unordered_map<uint64_t, std::string> m_names;
+    uint64_t m_dropped = 0;
+};
+
+#endif // UVM_OBJECTION_RECORDER_H
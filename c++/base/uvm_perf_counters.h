@@ -0,0 +1,404 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_PERF_COUNTERS_H
+#define UVM_PERF_COUNTERS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#endif
+#include <unistd.h>
+
+#include "base/uvm_component.h"
+#include "base/uvm_phase.h"
+#include "base/uvm_cmdline_processor.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_perf_counters
+//
+// Hardware performance counters per phase. Each thread that runs a
+// <UVM_PERF_COUNTER_SCOPE> opens one perf_event_open(2) group counting
+// user-mode cycles, instructions, cache misses and branch misses of that
+// thread; the group is read around every scope and the deltas are summed
+// per phase, or per phase and component:
+//
+//| +UVM_PERF_COUNTERS              per phase
+//| +UVM_PERF_COUNTERS=component    per phase and component
+//
+// <uvm_root::phase_ended> applies the plusargs when build ends and, from
+// then on, adds the counts of the thread that ends each phase since the
+// previous phase end to that phase; <uvm_root::report_phase> prints the
+// table, which gives IPC and misses per thousand instructions. Code that
+// runs a (component, phase) can place the scope around it for a breakdown
+// by component. When the kernel refuses the counters (perf_event_paranoid,
+// containers, non-Linux hosts) or an event does not exist on the CPU, the
+// affected columns are shown as n/a with the reason and the test runs on
+// unaffected. Counts are scaled when the kernel multiplexes the group.
+//
+// Defining UVM_NO_PERF_COUNTERS compiles the <UVM_PERF_COUNTER_SCOPE> probes
+// out; otherwise a disabled probe costs one branch.
+//------------------------------------------------------------------------------
+
+class uvm_perf_counters {
+public:
+    enum event_e { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_EVENTS };
+
+    struct values {
+        uint64_t v[NUM_EVENTS] = {};
+    };
+
+    struct summary {
+        std::string phase_name;
+        std::string comp_name;
+        uint64_t calls = 0;
+        values total;
+    };
+
+    static uvm_perf_counters* get() {
+        static uvm_perf_counters inst;
+        return &inst;
+    }
+
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+
+    bool get_per_component() const { return m_per_component; }
+    void set_per_component(bool on) { m_per_component = on; }
+
+    // Function: apply_plusargs
+    //
+    // Applies the +UVM_PERF_COUNTERS plusargs of the command line.
+    void apply_plusargs() {
+        std::vector<std::string> args;
+        uvm_cmdline_processor::get_inst()->get_plusargs(args);
+        m_init(args);
+    }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_PERF_COUNTERS entries of ~args~. Called by
+    // <uvm_root::phase_ended> when build ends.
+    void m_init(const std::vector<std::string>& args) {
+        for (const std::string& a : args) {
+            if (a == "+UVM_PERF_COUNTERS") {
+                set_enabled(true);
+            } else if (a == "+UVM_PERF_COUNTERS=component") {
+                set_enabled(true);
+                m_per_component = true;
+            }
+        }
+    }
+
+    // Function: read
+    //
+    // Reads the calling thread's counters, opening its group on first use.
+    // Returns false if the group could not be opened.
+    bool read(values& out) { return m_thread_group().read(out); }
+
+    // Function: add
+    //
+    // Adds the delta ~d~ of one execution of ~phase~ by ~comp~ to the
+    // calling thread's totals.
+    void add(uvm_component* comp, uvm_phase* phase, const values& d) {
+        thread_group& tg = m_thread_group();
+        std::lock_guard<std::mutex> lk(tg.data->mtx);
+        totals& t = tg.data->agg[{phase, m_per_component ? comp : nullptr}];
+        t.calls++;
+        for (int e = 0; e < NUM_EVENTS; e++) t.v.v[e] += d.v[e];
+    }
+
+    // Function- m_phase_ended
+    //
+    // Called by <uvm_root::phase_ended>. Adds the calling thread's counts
+    // since the previous call to ~phase~. The first call, and a call from
+    // a different thread than the previous one, only take the reading.
+    void m_phase_ended(uvm_phase* phase) {
+        if (!is_enabled()) return;
+        values now;
+        if (!read(now)) return;
+        std::thread::id self = std::this_thread::get_id();
+        values start;
+        bool have_start;
+        {
+            std::lock_guard<std::mutex> lk(m_mtx);
+            have_start = m_mark_valid && m_mark_thread == self;
+            start = m_mark;
+            m_mark = now;
+            m_mark_thread = self;
+            m_mark_valid = true;
+        }
+        if (have_start) add(nullptr, phase, m_delta(now, start));
+    }
+
+    // Function- m_delta
+    //
+    // ~end~ - ~start~ per event. Multiplexing scales each read separately,
+    // so the difference is clamped at zero.
+    static values m_delta(const values& end, const values& start) {
+        values d;
+        for (int e = 0; e < NUM_EVENTS; e++)
+            d.v[e] = end.v[e] > start.v[e] ? end.v[e] - start.v[e] : 0;
+        return d;
+    }
+
+    // Function: is_supported
+    //
+    // Whether event ~e~ could be opened on at least one thread.
+    bool is_supported(event_e e) const { return m_supported.load() & (1u << e); }
+
+    // Function: get_error
+    //
+    // Why counters are missing, empty if every event opened.
+    std::string get_error() const {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_error;
+    }
+
+    // Function: get_summary
+    //
+    // Totals per phase name (and component, in per-component mode), sorted
+    // by decreasing cycles.
+    std::vector<summary> get_summary() const {
+        std::map<std::pair<std::string, std::string>, summary> agg;
+        std::lock_guard<std::mutex> lk(m_mtx);
+        for (thread_data* td : m_threads) {
+            std::lock_guard<std::mutex> tlk(td->mtx);
+            for (const auto& e : td->agg) {
+                std::string phase_name = e.first.first ? e.first.first->get_name() : "";
+                std::string comp_name = e.first.second ? e.first.second->get_full_name() : "";
+                summary& s = agg[{phase_name, comp_name}];
+                s.phase_name = phase_name;
+                s.comp_name = comp_name;
+                s.calls += e.second.calls;
+                for (int i = 0; i < NUM_EVENTS; i++) s.total.v[i] += e.second.v.v[i];
+            }
+        }
+        std::vector<summary> v;
+        for (auto& e : agg) v.push_back(e.second);
+        std::sort(v.begin(), v.end(), [](const summary& a, const summary& b) {
+            return a.total.v[CYCLES] > b.total.v[CYCLES];
+        });
+        return v;
+    }
+
+    // Function: convert2string
+    //
+    // The IPC/miss-rate table printed at the end of the test.
+    std::string convert2string() const {
+        std::ostringstream os;
+        os << "\n--- UVM hardware counters per phase ---\n";
+        std::string err = get_error();
+        if (!err.empty()) os << "(" << err << ")\n";
+        if (!is_supported(CYCLES)) return os.str();
+        os << std::left << std::setw(12) << "Mcycles" << std::setw(12) << "Minstr" << std::setw(8) << "IPC"
+           << std::setw(12) << "cache MPKI" << std::setw(12) << "branch MPKI" << std::setw(8) << "calls"
+           << "phase\n";
+        os << std::fixed << std::setprecision(2);
+        for (const summary& s : get_summary()) {
+            const uint64_t* v = s.total.v;
+            double kinstr = v[INSTRUCTIONS] / 1e3;
+            os << std::left << std::setw(12) << v[CYCLES] / 1e6;
+            m_column(os, 12, is_supported(INSTRUCTIONS), v[INSTRUCTIONS] / 1e6);
+            m_column(os, 8, is_supported(INSTRUCTIONS) && v[CYCLES], double(v[INSTRUCTIONS]) / v[CYCLES]);
+            m_column(os, 12, is_supported(CACHE_MISSES) && kinstr > 0, v[CACHE_MISSES] / kinstr);
+            m_column(os, 12, is_supported(BRANCH_MISSES) && kinstr > 0, v[BRANCH_MISSES] / kinstr);
+            os << std::setw(8) << s.calls << s.phase_name;
+            if (!s.comp_name.empty()) os << "  " << s.comp_name;
+            os << "\n";
+        }
+        return os.str();
+    }
+
+    // Function: report
+    //
+    // Returns the table, or an empty string when disabled.
+    std::string report() const { return is_enabled() ? convert2string() : ""; }
+
+private:
+    struct totals {
+        uint64_t calls = 0;
+        values v;
+    };
+
+    // Per-thread totals; kept registered after the thread exits so that
+    // short-lived task-phase threads are still reported.
+    struct thread_data {
+        std::mutex mtx;
+        std::map<std::pair<uvm_phase*, uvm_component*>, totals> agg;
+    };
+
+    struct thread_group {
+        int fd[NUM_EVENTS] = {-1, -1, -1, -1};
+        uint64_t id[NUM_EVENTS] = {};
+        int leader = -1;
+        bool opened = false;
+        thread_data* data = nullptr;
+
+        ~thread_group() {
+            for (int f : fd)
+                if (f >= 0) ::close(f);
+        }
+
+        bool read(values& out) {
+            if (!opened) get()->m_open(*this);
+            if (leader < 0) return false;
+            // PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING | ID
+            uint64_t buf[3 + 2 * NUM_EVENTS];
+            if (::read(leader, buf, sizeof(buf)) <= 0) return false;
+            uint64_t nr = buf[0], enabled = buf[1], running = buf[2];
+            double scale = running && running < enabled ? double(enabled) / running : 1.0;
+            out = values();
+            for (uint64_t i = 0; i < nr && i < NUM_EVENTS; i++)
+                for (int e = 0; e < NUM_EVENTS; e++)
+                    if (fd[e] >= 0 && id[e] == buf[4 + 2 * i]) out.v[e] = uint64_t(buf[3 + 2 * i] * scale);
+            return true;
+        }
+    };
+
+    uvm_perf_counters() = default;
+
+    ~uvm_perf_counters() {
+        for (thread_data* td : m_threads) delete td;
+    }
+
+    thread_group& m_thread_group() {
+        static thread_local thread_group tg;
+        if (!tg.data) {
+            tg.data = new thread_data();
+            std::lock_guard<std::mutex> lk(m_mtx);
+            m_threads.push_back(tg.data);
+        }
+        return tg;
+    }
+
+    void m_open(thread_group& tg) {
+        tg.opened = true;
+#ifdef __linux__
+        static const uint64_t config[NUM_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        static const char* names[NUM_EVENTS] = {"cycles", "instructions", "cache-misses", "branch-misses"};
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config[e];
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING | PERF_FORMAT_ID;
+            attr.disabled = tg.leader < 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, tg.leader, 0));
+            if (fd < 0) {
+                m_set_error(std::string("perf_event_open(") + names[e] + "): " + std::strerror(errno) +
+                            (errno == EACCES || errno == EPERM ? "; see /proc/sys/kernel/perf_event_paranoid"
+                             : errno == ENOENT ? "; no such hardware event on this host" : ""));
+                if (e == CYCLES) return;   // no leader, no group
+                continue;
+            }
+            tg.fd[e] = fd;
+            ioctl(fd, PERF_EVENT_IOC_ID, &tg.id[e]);
+            if (tg.leader < 0) tg.leader = fd;
+            m_supported.fetch_or(1u << e);
+        }
+        ioctl(tg.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#else
+        m_set_error("hardware counters need Linux perf_event_open");
+#endif
+    }
+
+    void m_set_error(const std::string& s) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        if (m_error.empty()) m_error = s;
+    }
+
+    static void m_column(std::ostream& os, int w, bool ok, double v) {
+        if (ok) os << std::setw(w) << v;
+        else os << std::setw(w) << "n/a";
+    }
+
+    static inline std::atomic<bool> m_enabled{false};
+
+    bool m_per_component = false;
+    std::atomic<unsigned> m_supported{0};
+    mutable std::mutex m_mtx;
+    std::vector<thread_data*> m_threads;
+    std::string m_error;
+    values m_mark;
+    std::thread::id m_mark_thread;
+    bool m_mark_valid = false;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_perf_counter_scope
+//
+// RAII probe: reads the calling thread's counters on construction and on
+// destruction and adds the difference to the (component, phase). Placed
+// around a component's phase_started/exec/phase_ended sequence, it counts
+// that execution.
+//------------------------------------------------------------------------------
+
+class uvm_perf_counter_scope {
+public:
+    uvm_perf_counter_scope(uvm_component* comp, uvm_phase* phase) {
+        if (!uvm_perf_counters::is_enabled()) return;
+        m_active = uvm_perf_counters::get()->read(m_start);
+        m_comp = comp;
+        m_phase = phase;
+    }
+
+    ~uvm_perf_counter_scope() {
+        if (!m_active) return;
+        uvm_perf_counters* pc = uvm_perf_counters::get();
+        uvm_perf_counters::values end;
+        if (!pc->read(end)) return;
+        pc->add(m_comp, m_phase, uvm_perf_counters::m_delta(end, m_start));
+    }
+
+    uvm_perf_counter_scope(const uvm_perf_counter_scope&) = delete;
+    uvm_perf_counter_scope& operator=(const uvm_perf_counter_scope&) = delete;
+
+private:
+    bool m_active = false;
+    uvm_component* m_comp = nullptr;
+    uvm_phase* m_phase = nullptr;
+    uvm_perf_counters::values m_start;
+};
+
+#ifndef UVM_NO_PERF_COUNTERS
+#define UVM_PERF_COUNTER_SCOPE(COMP, PHASE) uvm_perf_counter_scope m_uvm_perf_counter_scope_(COMP, PHASE)
+#else
+#define UVM_PERF_COUNTER_SCOPE(COMP, PHASE)
+#endif
+
+#endif // UVM_PERF_COUNTERS_H
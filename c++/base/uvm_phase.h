@@ -32,6 +32,7 @@
 #include "base/uvm_object.h"
 #include "base/uvm_report_object.h"
 #include "base/uvm_object_globals.h"
+#include "base/uvm_mutex.h"
 
 class uvm_component;
 class uvm_objection;
@@ -516,7 +517,7 @@ private:
 
   // Thread management
   std::unordered_map<std::thread::id, std::thread*> m_threads;
-  std::mutex m_thread_mutex;
+  uvm_mutex m_thread_mutex{"uvm_phase::m_thread_mutex"};
   
   // Free all threads registered to this phase
   void free_threads();
@@ -0,0 +1,368 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_PHASE_PROFILER_H
+#define UVM_PHASE_PROFILER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <ctime>
+
+#include "base/uvm_component.h"
+#include "base/uvm_phase.h"
+#include "base/uvm_cmdline_processor.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_phase_profiler
+//
+// Records the wall time, CPU time and thread of every (component, phase)
+// execution wrapped in a <UVM_PHASE_PROFILE_SCOPE>. The phase execution code
+// lives in the out-of-line phasing sources and does not place these probes,
+// so a component profiles the phase methods it is interested in by opening
+// a scope in them. <uvm_root> applies the plusargs when build ends, so scopes
+// from connect on are recorded, and prints <report> from its report_phase.
+// Recording is off unless enabled (see <set_enabled>); the plusargs are:
+//
+//| +UVM_PHASE_PROFILE              enable, trace goes to uvm_phase_profile.json
+//| +UVM_PHASE_PROFILE=<file>       enable, trace goes to <file>
+//| +UVM_PHASE_PROFILE_TOP=<n>      rows of the summary table (default 20)
+//
+// Each thread appends to its own chunked buffer, so recording takes no lock.
+// <report> writes the records as Chrome trace-event JSON (load it in
+// chrome://tracing or Perfetto) and returns a top-N table.
+//
+// Defining UVM_NO_PHASE_PROFILE compiles the <UVM_PHASE_PROFILE_SCOPE> probes
+// out entirely; otherwise a disabled profiler costs one branch per probe.
+//------------------------------------------------------------------------------
+
+class uvm_phase_profiler {
+public:
+
+    struct record {
+        uvm_component* comp;
+        uvm_phase* phase;
+        int64_t start_ns;   // wall clock, relative to the profiler epoch
+        int64_t wall_ns;
+        int64_t cpu_ns;     // CPU time of the executing thread
+    };
+
+    struct summary {
+        std::string comp_name;
+        std::string phase_name;
+        uint64_t calls = 0;
+        int64_t wall_ns = 0;
+        int64_t cpu_ns = 0;
+    };
+
+    // Function: get
+    //
+    // Returns the singleton profiler.
+    static uvm_phase_profiler* get() {
+        static uvm_phase_profiler inst;
+        return &inst;
+    }
+
+    // Function: is_enabled
+    //
+    // Hot-path check used by the probes.
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Function: set_enabled
+    //
+    // Turns recording on or off programmatically.
+    static void set_enabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+
+    // Function: apply_plusargs
+    //
+    // Applies the +UVM_PHASE_PROFILE* plusargs.
+    void apply_plusargs() {
+        std::vector<std::string> args;
+        uvm_cmdline_processor::get_inst()->get_plusargs(args);
+        m_init(args);
+    }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_PHASE_PROFILE* entries of ~args~. Called by
+    // <uvm_root::phase_ended> when build ends.
+    void m_init(const std::vector<std::string>& args) {
+        for (const std::string& a : args) {
+            if (a == "+UVM_PHASE_PROFILE") {
+                set_enabled(true);
+            } else if (a.compare(0, 19, "+UVM_PHASE_PROFILE=") == 0) {
+                set_enabled(true);
+                m_trace_file = a.substr(19);
+            } else if (a.compare(0, 23, "+UVM_PHASE_PROFILE_TOP=") == 0) {
+                m_top_n = std::atoi(a.c_str() + 23);
+            }
+        }
+    }
+
+    // Function: now_ns
+    //
+    // Wall clock in nanoseconds since the profiler epoch.
+    int64_t now_ns() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch).count();
+    }
+
+    // Function: thread_cpu_ns
+    //
+    // CPU time consumed by the calling thread.
+    static int64_t thread_cpu_ns() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    // Function: add
+    //
+    // Appends a record to the calling thread's buffer. Lock-free except for
+    // the first record of a thread, which registers the buffer.
+    void add(const record& r) {
+        thread_buffer* tb = m_thread_buffer();
+        chunk* c = tb->tail;
+        size_t n = c->count.load(std::memory_order_relaxed);
+        if (n == chunk::CAPACITY) {
+            chunk* nc = new chunk();
+            c->next.store(nc, std::memory_order_release);
+            tb->tail = c = nc;
+            n = 0;
+        }
+        c->records[n] = r;
+        c->count.store(n + 1, std::memory_order_release);
+    }
+
+    // Function: for_each
+    //
+    // Calls ~f(record, thread_index)~ for every record published so far.
+    template <typename F>
+    void for_each(F f) const {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        for (const thread_buffer* tb : m_threads) {
+            for (const chunk* c = &tb->head; c; c = c->next.load(std::memory_order_acquire)) {
+                size_t n = c->count.load(std::memory_order_acquire);
+                for (size_t i = 0; i < n; i++) f(c->records[i], tb->index);
+            }
+        }
+    }
+
+    // Function: get_summary
+    //
+    // Aggregates the records per (component, phase) pair, sorted by
+    // decreasing wall time. ~top_n~ of 0 returns every pair.
+    std::vector<summary> get_summary(size_t top_n = 0) const {
+        std::map<std::pair<uvm_component*, std::string>, summary> agg;
+        for_each([&](const record& r, int) {
+            std::string phase_name = r.phase ? r.phase->get_name() : "";
+            summary& s = agg[{r.comp, phase_name}];
+            if (s.calls == 0) {
+                s.comp_name = r.comp ? r.comp->get_full_name() : "";
+                s.phase_name = phase_name;
+            }
+            s.calls++;
+            s.wall_ns += r.wall_ns;
+            s.cpu_ns += r.cpu_ns;
+        });
+        std::vector<summary> v;
+        for (auto& e : agg) v.push_back(e.second);
+        std::sort(v.begin(), v.end(), [](const summary& a, const summary& b) { return a.wall_ns > b.wall_ns; });
+        if (top_n && v.size() > top_n) v.resize(top_n);
+        return v;
+    }
+
+    // Function: write_chrome_trace
+    //
+    // Writes the records as Chrome trace-event JSON ("X" complete events,
+    // timestamps in microseconds). Returns false if the file can't be opened.
+    bool write_chrome_trace(const std::string& filename = "") const {
+        std::ofstream os(filename.empty() ? m_trace_file : filename);
+        if (!os) return false;
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for_each([&](const record& r, int tid) {
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "{\"name\":\"" << m_json_escape(r.phase ? r.phase->get_name() : "")
+               << "\",\"cat\":\"phase\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+               << std::fixed << std::setprecision(3)
+               << ",\"ts\":" << r.start_ns / 1e3 << ",\"dur\":" << r.wall_ns / 1e3
+               << ",\"args\":{\"component\":\"" << m_json_escape(r.comp ? r.comp->get_full_name() : "")
+               << "\",\"cpu_us\":" << r.cpu_ns / 1e3 << "}}";
+        });
+        os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return bool(os);
+    }
+
+    // Function: convert2string
+    //
+    // Formats the top-N table.
+    std::string convert2string() const {
+        std::ostringstream os;
+        os << "\n--- UVM Phase Profile (top " << m_top_n << " by wall time) ---\n";
+        os << std::left << std::setw(12) << "wall(ms)" << std::setw(12) << "cpu(ms)" << std::setw(8) << "calls"
+           << std::setw(24) << "phase" << "component\n";
+        os << std::fixed << std::setprecision(3);
+        for (const summary& s : get_summary(m_top_n)) {
+            os << std::left << std::setw(12) << s.wall_ns / 1e6 << std::setw(12) << s.cpu_ns / 1e6
+               << std::setw(8) << s.calls << std::setw(24) << s.phase_name << s.comp_name << "\n";
+        }
+        return os.str();
+    }
+
+    // Function: report
+    //
+    // Writes the trace file and returns the table, or an empty string when
+    // disabled.
+    std::string report() {
+        if (!is_enabled()) return "";
+        std::string s = convert2string();
+        if (write_chrome_trace()) s += "Phase trace written to " + m_trace_file + "\n";
+        return s;
+    }
+
+    // Function: clear
+    //
+    // Drops all records. Must not race with threads that are recording.
+    void clear() {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        for (thread_buffer* tb : m_threads) {
+            m_free_chain(tb->head.next.exchange(nullptr));
+            tb->head.count.store(0);
+            tb->tail = &tb->head;
+        }
+    }
+
+    std::string get_trace_file() const { return m_trace_file; }
+    void set_trace_file(const std::string& f) { m_trace_file = f; }
+    size_t get_top_n() const { return m_top_n; }
+    void set_top_n(size_t n) { m_top_n = n; }
+
+private:
+    struct chunk {
+        static const size_t CAPACITY = 1024;
+        record records[CAPACITY];
+        std::atomic<size_t> count{0};
+        std::atomic<chunk*> next{nullptr};
+    };
+
+    struct thread_buffer {
+        chunk head;
+        chunk* tail = &head;
+        int index = 0;
+    };
+
+    uvm_phase_profiler() : m_epoch(std::chrono::steady_clock::now()) {}
+
+    ~uvm_phase_profiler() {
+        for (thread_buffer* tb : m_threads) {
+            m_free_chain(tb->head.next.load());
+            delete tb;
+        }
+    }
+
+    static void m_free_chain(chunk* c) {
+        while (c) {
+            chunk* n = c->next.load();
+            delete c;
+            c = n;
+        }
+    }
+
+    // Buffers stay registered after their thread exits so that records of
+    // short-lived task-phase threads survive until the report.
+    thread_buffer* m_thread_buffer() {
+        static thread_local thread_buffer* tb = nullptr;
+        if (!tb) {
+            tb = new thread_buffer();
+            std::lock_guard<std::mutex> lk(m_mtx);
+            tb->index = static_cast<int>(m_threads.size());
+            m_threads.push_back(tb);
+        }
+        return tb;
+    }
+
+    static std::string m_json_escape(const std::string& s) {
+        std::string r;
+        for (char c : s) {
+            if (c == '"' || c == '\\') r += '\\';
+            r += c;
+        }
+        return r;
+    }
+
+    static inline std::atomic<bool> m_enabled{false};
+
+    std::chrono::steady_clock::time_point m_epoch;
+    mutable std::mutex m_mtx;
+    std::vector<thread_buffer*> m_threads;
+    std::string m_trace_file = "uvm_phase_profile.json";
+    size_t m_top_n = 20;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_phase_profile_scope
+//
+// RAII probe that records one (component, phase) execution, from its
+// construction to its destruction, on the calling thread.
+//------------------------------------------------------------------------------
+
+class uvm_phase_profile_scope {
+public:
+    uvm_phase_profile_scope(uvm_component* comp, uvm_phase* phase) {
+        if (!uvm_phase_profiler::is_enabled()) return;
+        m_active = true;
+        m_rec.comp = comp;
+        m_rec.phase = phase;
+        m_rec.start_ns = uvm_phase_profiler::get()->now_ns();
+        m_cpu_start = uvm_phase_profiler::thread_cpu_ns();
+    }
+
+    ~uvm_phase_profile_scope() {
+        if (!m_active) return;
+        uvm_phase_profiler* p = uvm_phase_profiler::get();
+        m_rec.wall_ns = p->now_ns() - m_rec.start_ns;
+        m_rec.cpu_ns = uvm_phase_profiler::thread_cpu_ns() - m_cpu_start;
+        p->add(m_rec);
+    }
+
+    uvm_phase_profile_scope(const uvm_phase_profile_scope&) = delete;
+    uvm_phase_profile_scope& operator=(const uvm_phase_profile_scope&) = delete;
+
+private:
+    bool m_active = false;
+    uvm_phase_profiler::record m_rec;
+    int64_t m_cpu_start = 0;
+};
+
+#ifndef UVM_NO_PHASE_PROFILE
+#define UVM_PHASE_PROFILE_SCOPE(COMP, PHASE) uvm_phase_profile_scope m_uvm_phase_profile_scope_(COMP, PHASE)
+#else
+#define UVM_PHASE_PROFILE_SCOPE(COMP, PHASE)
+#endif
+
+#endif // UVM_PHASE_PROFILER_H
@@ -33,6 +33,7 @@
 #include "base/uvm_phase.h"
 #include "base/uvm_globals.h"
 #include "base/uvm_domain.h"
+#include "base/uvm_port_stats.h"
 
 const int UVM_UNBOUNDED_CONNECTIONS = -1;
 const std::string s_connection_error_id = "Connection Error";
@@ -454,6 +455,55 @@ public:
         return nullptr;
     }
 
+    // Function: m_txn_begin
+    //
+    // To be called on entry of a put/get/peek/transport/write
+    // implementation that reports to <uvm_port_stats>. Returns the entry
+    // time, or 0 when port statistics are off.
+    int64_t m_txn_begin() {
+        return uvm_port_stats::is_enabled() ? uvm_port_stats::now_ns() : 0;
+    }
+
+    // Function: m_txn_end
+    //
+    // Called on return with the value of <m_txn_begin>; ~blocking~ selects
+    // whether the call duration is kept as latency. See <uvm_port_stats>.
+    void m_txn_end(int64_t start_ns, bool blocking) {
+        if (start_ns == 0) return;
+        uvm_port_stats* st = m_stats.load(std::memory_order_acquire);
+        if (st == nullptr) {
+            uvm_port_stats* created = uvm_port_stats_registry::get()->create(get_full_name());
+            st = m_stats.compare_exchange_strong(st, created, std::memory_order_acq_rel) ? created : st;
+        }
+        st->record(start_ns, uvm_port_stats::now_ns(), blocking);
+    }
+
+    // Class: m_txn_scope
+    //
+    // Brackets one transaction with <m_txn_begin> and <m_txn_end>, so that a
+    // put/get/peek/transport/write implementation records it with a single
+    // declaration at the top of its body, including when it returns early
+    // or throws:
+    //
+    //|  void put(const T& t) {
+    //|      typename this_type::m_txn_scope txn(this, true);
+    //|      ...
+    //|  }
+    class m_txn_scope {
+    public:
+        m_txn_scope(this_type* port, bool blocking)
+            : m_port(port), m_blocking(blocking), m_start(port->m_txn_begin()) {}
+        ~m_txn_scope() { m_port->m_txn_end(m_start, m_blocking); }
+        m_txn_scope(const m_txn_scope&) = delete;
+        m_txn_scope& operator=(const m_txn_scope&) = delete;
+    private:
+        this_type* m_port;
+        bool m_blocking;
+        int64_t m_start;
+    };
+
+    uvm_port_stats* get_stats() const { return m_stats.load(std::memory_order_acquire); }
+
 //private:
     bool m_check_relationship(this_type* provider) {
         std::string s;
@@ -508,6 +558,7 @@ public:
     int m_max_size;
     bool m_resolved;
     std::map<std::string, this_type*> m_imp_list;
+    std::atomic<uvm_port_stats*> m_stats{nullptr};
 
 protected:
     u_int32_t m_if_mask;
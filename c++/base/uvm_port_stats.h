@@ -0,0 +1,166 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_PORT_STATS_H
+#define UVM_PORT_STATS_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <algorithm>
+
+#include "base/uvm_histogram.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_port_stats
+//
+// Transaction statistics of one TLM port: number of transactions, the
+// inter-arrival time between consecutive calls and, for blocking calls
+// (put, get, peek, transport), the time spent inside the call. Times are
+// in nanoseconds of the steady clock.
+//
+// Collection is off unless ~+UVM_PORT_STATS~ is given (applied by
+// <uvm_root::phase_ended> when build ends) or <set_enabled> is called. Only
+// transactions that an implementation brackets with
+// <uvm_port_base::m_txn_begin> and <uvm_port_base::m_txn_end>, usually
+// through <uvm_port_base::m_txn_scope>, are counted;
+// while collection is off, that costs one relaxed load, and a port's stats
+// are only allocated on its first counted transaction once on.
+//------------------------------------------------------------------------------
+
+class uvm_port_stats {
+public:
+    typedef uvm_log_histogram<> histogram;
+
+    explicit uvm_port_stats(const std::string& name) : m_name(name) {}
+
+    static bool is_enabled() { return m_enabled.load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { m_enabled.store(on, std::memory_order_relaxed); }
+
+    // Function: m_init
+    //
+    // Enables collection if ~+UVM_PORT_STATS~ is among ~plusargs~.
+    static void m_init(const std::vector<std::string>& plusargs) {
+        if (std::find(plusargs.begin(), plusargs.end(), "+UVM_PORT_STATS") != plusargs.end()) set_enabled(true);
+    }
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Function: record
+    //
+    // Records a transaction that entered the port at ~start_ns~ and returned
+    // at ~end_ns~. The latency is only kept for blocking calls.
+    void record(int64_t start_ns, int64_t end_ns, bool blocking) {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        int64_t prev = m_last_ns.exchange(start_ns, std::memory_order_relaxed);
+        if (prev == 0) {
+            m_first_ns.store(start_ns, std::memory_order_relaxed);
+        } else if (start_ns > prev) {
+            m_inter_arrival.record(start_ns - prev);
+        }
+        if (blocking) m_latency.record(end_ns - start_ns);
+    }
+
+    const std::string& get_name() const { return m_name; }
+    uint64_t get_count() const { return m_count.load(std::memory_order_relaxed); }
+    const histogram& get_inter_arrival() const { return m_inter_arrival; }
+    const histogram& get_latency() const { return m_latency; }
+
+    // Function: get_rate
+    //
+    // Transactions per second between the first and the last transaction.
+    double get_rate() const {
+        int64_t span = m_last_ns.load() - m_first_ns.load();
+        return span > 0 ? (get_count() - 1) * 1e9 / span : 0;
+    }
+
+    std::string convert2string() const {
+        std::ostringstream os;
+        os << m_name << ": " << get_count() << " txns, " << get_rate() << " txn/s\n"
+           << "  inter-arrival(us) " << m_inter_arrival.convert2string(1e3) << "\n";
+        if (m_latency.get_count())
+            os << "  latency(us)       " << m_latency.convert2string(1e3) << "\n";
+        return os.str();
+    }
+
+private:
+    static inline std::atomic<bool> m_enabled{false};
+
+    std::string m_name;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<int64_t> m_first_ns{0};
+    std::atomic<int64_t> m_last_ns{0};
+    histogram m_inter_arrival;
+    histogram m_latency;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_port_stats_registry
+//
+// Owns the <uvm_port_stats> of every port that saw traffic, keyed by the
+// port's full name, and dumps them from <uvm_root::report_phase>.
+//------------------------------------------------------------------------------
+
+class uvm_port_stats_registry {
+public:
+    static uvm_port_stats_registry* get() {
+        static uvm_port_stats_registry inst;
+        return &inst;
+    }
+
+    uvm_port_stats* create(const std::string& full_name) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        m_stats.emplace_back(new uvm_port_stats(full_name));
+        return m_stats.back();
+    }
+
+    std::vector<const uvm_port_stats*> get_all() const {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        std::vector<const uvm_port_stats*> v(m_stats.begin(), m_stats.end());
+        std::sort(v.begin(), v.end(), [](const uvm_port_stats* a, const uvm_port_stats* b) {
+            return a->get_name() < b->get_name();
+        });
+        return v;
+    }
+
+    std::string convert2string() const {
+        std::string s = "\n--- UVM port statistics ---\n";
+        for (const uvm_port_stats* p : get_all())
+            if (p->get_count()) s += p->convert2string();
+        return s;
+    }
+
+    ~uvm_port_stats_registry() {
+        for (uvm_port_stats* p : m_stats) delete p;
+    }
+
+private:
+    uvm_port_stats_registry() = default;
+
+    mutable std::mutex m_mtx;
+    std::vector<uvm_port_stats*> m_stats;
+};
+
+#endif // UVM_PORT_STATS_H
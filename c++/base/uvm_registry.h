@@ -23,6 +23,7 @@
 
 #include <string>
 #include <iostream>
+#include <typeinfo>
 #include "base/uvm_factory.h"
 #include "base/uvm_component.h"
 #include "base/uvm_object.h"
@@ -79,9 +80,21 @@ public:
     // implements this method to create a component of a specific type, T.
     virtual uvm_component* create_component(const std::string &name = "", uvm_component* parent = nullptr) override {
         //return dynamic_cast<uvm_component*>(this_type::create(name, parent));
-        return new T(name, parent);
+        T* comp = new T(name, parent);
+        comp->m_type_stats.attach(m_get_type_stats());
+        if (uvm_metrics::is_enabled())
+            uvm_framework_metrics::get()->factory_creations.inc();
+        return comp;
     };
 
+    // Function- m_get_type_stats
+    // Live-instance accounting for T, see <uvm_type_accounting>.
+    static uvm_type_stats* m_get_type_stats() {
+        static uvm_type_stats* stats = uvm_type_accounting::get()->register_type(
+            type_name != "__UNDEF__" ? type_name : typeid(T).name(), sizeof(T));
+        return stats;
+    }
+
     // Function: create
     // Returns an instance of the component type, T, represented by this proxy.
     static T* create(const std::string &name, uvm_component* parent, const std::string &contxt = "") {
@@ -139,12 +152,23 @@ public:
     // Creates an object of type T and returns it as a handle to an uvm_object.
     virtual uvm_object* create_object(const std::string &name = "") override {
         T* obj = new T();
+        obj->m_type_stats.attach(m_get_type_stats());
+        if (uvm_metrics::is_enabled())
+            uvm_framework_metrics::get()->factory_creations.inc();
         if (!name.empty()) {
             obj->set_name(name);
         }
         return obj;
     }
 
+    // Function- m_get_type_stats
+    // Live-instance accounting for T, see <uvm_type_accounting>.
+    static uvm_type_stats* m_get_type_stats() {
+        static uvm_type_stats* stats = uvm_type_accounting::get()->register_type(
+            type_name != "__UNDEF__" ? type_name : typeid(T).name(), sizeof(T));
+        return stats;
+    }
+
     // Function: create_component
     // Since this is an object registry, this function should return nullptr.
     virtual uvm_component* create_component(const std::string &name = "", uvm_component* parent = nullptr) override {
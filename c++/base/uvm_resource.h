@@ -29,6 +29,9 @@
 #include <regex>
 #include <ctime>
 #include <memory>
+#include <cstring>
+#include <type_traits>
+#include <typeinfo>
 
 #include "base/uvm_object.h"
 #include "base/uvm_regex.h"
@@ -231,6 +234,8 @@ public:
     std::string get_scope() const { return scope; }
 
     bool match_scope(const std::string& s) const {
+        if (uvm_metrics::is_enabled())
+            uvm_framework_metrics::get()->config_regex_evals.inc();
         try {
             std::regex regex_pattern(scope);
             bool match = std::regex_search(s, regex_pattern);
@@ -257,6 +262,28 @@ public:
 
     virtual std::string convert2string() const { return "?"; }
 
+    // Function- m_save_value/m_restore_value
+    //
+    // Raw image of the value, used by <uvm_checkpoint>. Only trivially
+    // copyable (non-pointer) and std::string values have one; for other types
+    // both return false.
+    virtual bool m_save_value(std::string&) const { return false; }
+    virtual bool m_restore_value(const char*, size_t) { return false; }
+
+    // Function- m_type_name/m_create
+    //
+    // Name of the value type, and creation of an empty resource of that type
+    // with the given name and (already converted) scope regex. Each
+    // uvm_resource<T>::get_type() handle is listed in <m_type_handles> under
+    // its m_type_name(), so a checkpoint can recreate resources by type.
+    virtual std::string m_type_name() const { return ""; }
+    virtual uvm_resource_base* m_create(const std::string&, const std::string&) const { return nullptr; }
+
+    static std::unordered_map<std::string, uvm_resource_base*>& m_type_handles() {
+        static std::unordered_map<std::string, uvm_resource_base*> handles;
+        return handles;
+    }
+
     void do_print() const {
         uvm_info("RESOURCE_PRINT", get_name() + " [" + get_scope() + "] : " + convert2string(), UVM_LOW);
     }
@@ -338,6 +365,20 @@ public:
         return rp;
     }
 
+    // Function- m_get_resources
+    //
+    // Every resource in the pool, ordered by name and, within a name, in
+    // lookup order; used by <uvm_checkpoint>.
+    void m_get_resources(std::vector<uvm_resource_base*>& rsrcs) const {
+        std::vector<const std::string*> names;
+        for (const auto& [name, q] : rtab) names.push_back(&name);
+        std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+        for (const std::string* name : names) {
+            const auto& q = rtab.at(*name);
+            rsrcs.insert(rsrcs.end(), q.begin(), q.end());
+        }
+    }
+
     bool spell_check(const std::string& s) const {
         return rtab.find(s) != rtab.end();
     }
@@ -517,6 +558,8 @@ public:
             uvm_info("REGEX_MATCH", "Attempting to match name: " + name + " against regex: " + regex_pattern_str, UVM_FULL);
 
             for (auto* r : rq) {
+                if (uvm_metrics::is_enabled())
+                    uvm_framework_metrics::get()->config_regex_evals.inc();
                 // Use the uvm_is_match helper function to perform the matching
                 if (uvm_is_match(regex_pattern_str, name)) {
                     // Check if the type and scope match
@@ -542,6 +585,8 @@ public:
         std::regex regex_pattern(re);
 
         for (auto& [name, rq] : rtab) {
+            if (uvm_metrics::is_enabled())
+                uvm_framework_metrics::get()->config_regex_evals.inc();
             if (!std::regex_match(name, regex_pattern)) continue;
             for (auto* r : rq) {
                 if (r->match_scope(scope))
@@ -739,10 +784,47 @@ public:
     }
 
     static this_type* get_type() {
-        static this_type* my_type_instance = new this_type();
+        static this_type* my_type_instance = [] {
+            this_type* h = new this_type();
+            m_type_handles()[typeid(T).name()] = h;
+            return h;
+        }();
         return my_type_instance;
     }
 
+    std::string m_type_name() const override { return typeid(T).name(); }
+
+    uvm_resource_base* m_create(const std::string& name, const std::string& scope_re) const override {
+        this_type* r = new this_type(name);
+        r->scope = scope_re;
+        return r;
+    }
+
+    bool m_save_value(std::string& bytes) const override {
+        if constexpr (std::is_same_v<T, std::string>) {
+            bytes = val;
+            return true;
+        } else if constexpr (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>) {
+            bytes.assign(reinterpret_cast<const char*>(&val), sizeof(T));
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool m_restore_value(const char* p, size_t n) override {
+        if constexpr (std::is_same_v<T, std::string>) {
+            val.assign(p, n);
+        } else if constexpr (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>) {
+            if (n != sizeof(T)) return false;
+            std::memcpy(static_cast<void*>(&val), p, n);
+        } else {
+            return false;
+        }
+        modified = true;
+        return true;
+    }
+
     uvm_resource_base* get_type_handle() const override {
         return get_type();
     }
@@ -33,6 +33,13 @@
 #include "base/uvm_printer.h"
 #include "base/uvm_cmdline_processor.h"
 #include "base/uvm_report_handler.h"
+#include "base/uvm_port_stats.h"
+#include "base/uvm_phase_profiler.h"
+#include "base/uvm_objection_recorder.h"
+#include "base/uvm_sample_profiler.h"
+#include "base/uvm_mutex.h"
+#include "base/uvm_perf_counters.h"
+#include "base/uvm_checkpoint.h"
 #include "time_proc/uvm_delay_process.h"
 
 class uvm_phase;
@@ -112,6 +119,14 @@ public:
     // the command line without forcing recompilation. If the global (package)
     // variable, finish_on_completion, is set, then $finish is called after
     // phasing completes.
+    //
+    // The ~+UVM_OBJECT_ACCOUNTING~, ~+UVM_PORT_STATS~, ~+UVM_METRICS~,
+    // ~+UVM_PHASE_PROFILE~, ~+UVM_OBJECTION_RECORD~, ~+UVM_SAMPLE_PROFILE~,
+    // ~+UVM_LOCK_PROFILE~ and ~+UVM_PERF_COUNTERS~ plusargs are applied when
+    // build ends (see <phase_ended>).
+    //
+    // ~+UVM_CHECKPOINT_SAVE~ and ~+UVM_CHECKPOINT_RESTORE~ save or resume from
+    // a phase boundary; see <phase_ended> and <uvm_checkpoint>.
     virtual void run_test(const std::string& test_name = "");
 
     // Variable: top_levels
@@ -175,6 +190,102 @@ public:
     virtual void run_phase(uvm_phase* phase);
     virtual void phase_started(uvm_phase* phase);
 
+    // Function: report_phase
+    //
+    // Prints the per-type live-object table when ~+UVM_OBJECT_ACCOUNTING~ is
+    // given (see <uvm_type_accounting>), the per-port transaction
+    // statistics when ~+UVM_PORT_STATS~ is given (see <uvm_port_stats>), and
+    // the phase profile table when ~+UVM_PHASE_PROFILE~ is given (see
+    // <uvm_phase_profiler::report>, which also writes the trace file). With
+    // ~+UVM_OBJECTION_RECORD~, writes the objection event dump and prints
+    // its analysis (see <uvm_objection_analyzer>). With ~+UVM_SAMPLE_PROFILE~,
+    // stops sampling and writes the flat and folded profiles (see
+    // <uvm_sample_profiler::write_reports>). With ~+UVM_LOCK_PROFILE~, prints
+    // the most contended framework locks (see <uvm_lock_registry>). With
+    // ~+UVM_PERF_COUNTERS~, prints the hardware counters per phase (see
+    // <uvm_perf_counters>).
+    virtual void report_phase(uvm_phase*) override {
+        if (uvm_type_accounting::get()->get_dump_at_report())
+            uvm_info("UVM/OBJ_ACCOUNTING", uvm_type_accounting::get()->convert2string(), UVM_NONE);
+        if (uvm_port_stats::is_enabled())
+            uvm_info("UVM/PORT_STATS", uvm_port_stats_registry::get()->convert2string(), UVM_NONE);
+        if (uvm_phase_profiler::is_enabled())
+            uvm_info("UVM/PHASE_PROFILE", uvm_phase_profiler::get()->report(), UVM_NONE);
+        if (uvm_objection_recorder::is_enabled()) {
+            uvm_objection_recorder* rec = uvm_objection_recorder::get();
+            uvm_objection_analyzer an;
+            an.load_live(rec);
+            std::string s = an.convert2string();
+            if (rec->write()) s += "Objection events written to " + rec->get_file() + "\n";
+            uvm_info("UVM/OBJ_RECORD", s, UVM_NONE);
+        }
+        if (uvm_sample_profiler::get()->is_running()) {
+            uvm_sample_profiler* sp = uvm_sample_profiler::get();
+            if (sp->write_reports())
+                uvm_info("UVM/SAMPLE_PROFILE", "Profiles written to " + sp->get_prefix() + ".flat.txt and " +
+                         sp->get_prefix() + ".folded", UVM_NONE);
+            else
+                uvm_warning("UVM/SAMPLE_PROFILE", "Could not write profiles to " + sp->get_prefix() + ".*");
+        }
+        if (uvm_lock_registry::is_enabled())
+            uvm_info("UVM/LOCK_PROFILE", uvm_lock_registry::get()->convert2string(), UVM_NONE);
+        if (uvm_perf_counters::is_enabled())
+            uvm_info("UVM/PERF_COUNTERS", uvm_perf_counters::get()->convert2string(), UVM_NONE);
+    }
+
+    // Function: phase_ended
+    //
+    // Saves a <uvm_checkpoint> when the ~+UVM_CHECKPOINT_PHASE~ phase ends,
+    // and restores one when pre_reset ends (see <uvm_checkpoint::m_phase_ended>).
+    // When build ends, applies the ~+UVM_OBJECT_ACCOUNTING~ plusargs (see
+    // <uvm_type_accounting::m_init>; objects are counted from the start
+    // either way), ~+UVM_PORT_STATS~ (<uvm_port_stats::m_init>),
+    // ~+UVM_METRICS~ (<uvm_metrics::m_init>), ~+UVM_PHASE_PROFILE~
+    // (<uvm_phase_profiler::m_init>), ~+UVM_OBJECTION_RECORD~
+    // (<uvm_objection_recorder::m_init>), ~+UVM_SAMPLE_PROFILE~
+    // (<uvm_sample_profiler::m_init>), ~+UVM_LOCK_PROFILE~
+    // (<uvm_lock_registry::m_init>) and ~+UVM_PERF_COUNTERS~
+    // (<uvm_perf_counters::m_init>). Each phase end after that is also a
+    // <uvm_perf_counters::m_phase_ended> boundary.
+    virtual void phase_ended(uvm_phase* phase) override {
+        if (phase->get_name() == "build") {
+            std::vector<std::string> args;
+            clp->get_plusargs(args);
+            uvm_type_accounting::get()->m_init(args);
+            uvm_port_stats::m_init(args);
+            uvm_metrics::get()->m_init(args);
+            uvm_phase_profiler::get()->m_init(args);
+            uvm_objection_recorder::get()->m_init(args);
+            uvm_sample_profiler::get()->m_init(args);
+            uvm_lock_registry::get()->m_init(args);
+            uvm_perf_counters::get()->m_init(args);
+        }
+        uvm_perf_counters::get()->m_phase_ended(phase);
+        uvm_checkpoint::get()->m_phase_ended(phase, this);
+    }
+
+    // Functions: raised, dropped, all_dropped
+    //
+    // Record the objection activity that reaches the top while
+    // ~+UVM_OBJECTION_RECORD~ is given (see <uvm_objection_recorder::record_top>).
+    virtual void raised(uvm_objection* objection, uvm_object* source_obj,
+                        const std::string&, int count) override {
+        if (uvm_objection_recorder::is_enabled())
+            uvm_objection_recorder::get()->record_top(objection, this, source_obj, count, UVM_RAISED);
+    }
+
+    virtual void dropped(uvm_objection* objection, uvm_object* source_obj,
+                         const std::string&, int count) override {
+        if (uvm_objection_recorder::is_enabled())
+            uvm_objection_recorder::get()->record_top(objection, this, source_obj, -count, UVM_DROPPED);
+    }
+
+    virtual void all_dropped(uvm_objection* objection, uvm_object* source_obj,
+                             const std::string&, int) override {
+        if (uvm_objection_recorder::is_enabled())
+            uvm_objection_recorder::get()->record_top(objection, this, source_obj, 0, UVM_ALL_DROPPED);
+    }
+
 protected:
     uvm_root();
     virtual ~uvm_root() = default;
@@ -0,0 +1,387 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_SAMPLE_PROFILER_H
+#define UVM_SAMPLE_PROFILER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <typeinfo>
+#include <cstdlib>
+#include <csignal>
+#include <thread>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+
+#include "base/uvm_component.h"
+#include "base/uvm_phase.h"
+#include "base/uvm_cmdline_processor.h"
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_profile_context
+//
+// What the calling thread is working on: the component and phase set by the
+// innermost <uvm_profile_context_scope>, and the type of the sequence item
+// set by <uvm_profile_item_scope>, if any. Kept in a thread-local so the
+// SIGPROF handler of <uvm_sample_profiler> can read it without locking.
+//------------------------------------------------------------------------------
+
+struct uvm_profile_context {
+    uvm_component* comp = nullptr;
+    uvm_phase* phase = nullptr;
+    const char* item_type = nullptr;   // mangled typeid name
+
+    static uvm_profile_context& current() {
+        static thread_local uvm_profile_context ctx __attribute__((tls_model("initial-exec")));
+        return ctx;
+    }
+};
+
+// Sets the component/phase of the calling thread for the lifetime of the
+// scope. Nests: the previous context is restored on exit.
+class uvm_profile_context_scope {
+public:
+    uvm_profile_context_scope(uvm_component* comp, uvm_phase* phase) : m_saved(uvm_profile_context::current()) {
+        uvm_profile_context& ctx = uvm_profile_context::current();
+        ctx.comp = comp;
+        if (phase) ctx.phase = phase;
+        ctx.item_type = nullptr;
+    }
+    ~uvm_profile_context_scope() { uvm_profile_context::current() = m_saved; }
+
+    uvm_profile_context_scope(const uvm_profile_context_scope&) = delete;
+    uvm_profile_context_scope& operator=(const uvm_profile_context_scope&) = delete;
+
+private:
+    uvm_profile_context m_saved;
+};
+
+// Tags samples with the type of ~item~ while a driver or sequencer works on it.
+class uvm_profile_item_scope {
+public:
+    explicit uvm_profile_item_scope(const uvm_object* item) : m_saved(uvm_profile_context::current().item_type) {
+        uvm_profile_context::current().item_type = item ? typeid(*item).name() : nullptr;
+    }
+    ~uvm_profile_item_scope() { uvm_profile_context::current().item_type = m_saved; }
+
+    uvm_profile_item_scope(const uvm_profile_item_scope&) = delete;
+    uvm_profile_item_scope& operator=(const uvm_profile_item_scope&) = delete;
+
+private:
+    const char* m_saved;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_sample_profiler
+//
+// Opt-in statistical profiler. An ITIMER_PROF timer delivers SIGPROF at a
+// fixed rate of consumed CPU time; the handler copies the interrupted
+// thread's <uvm_profile_context> and program counter into a preallocated
+// sample array. <write_reports> aggregates them into
+//
+// - ~<prefix>.flat.txt~: samples per component, per phase and per leaf function
+// - ~<prefix>.folded~: collapsed stacks (phase;component path;item;function)
+//   in the format read by flamegraph.pl and speedscope
+//
+// Leaf functions are resolved with dladdr(), so the executable should be
+// linked with -rdynamic for its own symbols to appear by name.
+//
+// <uvm_root> applies the plusargs when build ends and calls <write_reports>
+// from its report_phase. Samples are attributed to the contexts that code
+// places with <uvm_profile_context_scope> and <uvm_profile_item_scope>; the
+// out-of-line phase execution code does not place them, so samples taken
+// outside such a scope count as ~<none>~ in the component and phase views
+// and still appear in the function view.
+//
+//| +UVM_SAMPLE_PROFILE[=<prefix>]    enable (default prefix uvm_sample_profile)
+//| +UVM_SAMPLE_PROFILE_HZ=<hz>       sampling rate (default 997)
+//| +UVM_SAMPLE_PROFILE_MAX=<n>       sample capacity (default 1M)
+//------------------------------------------------------------------------------
+
+class uvm_sample_profiler {
+public:
+
+    struct sample {
+        uvm_component* comp;
+        uvm_phase* phase;
+        const char* item_type;
+        void* pc;
+    };
+
+    static uvm_sample_profiler* get() {
+        static uvm_sample_profiler inst;
+        return &inst;
+    }
+
+    // Function: apply_plusargs
+    //
+    // Applies the +UVM_SAMPLE_PROFILE* plusargs and starts sampling if
+    // +UVM_SAMPLE_PROFILE is given.
+    void apply_plusargs() {
+        std::vector<std::string> args;
+        uvm_cmdline_processor::get_inst()->get_plusargs(args);
+        m_init(args);
+    }
+
+    // Function- m_init
+    //
+    // Applies the +UVM_SAMPLE_PROFILE* entries of ~args~. Called by
+    // <uvm_root::phase_ended> when build ends.
+    void m_init(const std::vector<std::string>& args) {
+        bool on = false;
+        for (const std::string& a : args) {
+            if (a == "+UVM_SAMPLE_PROFILE") {
+                on = true;
+            } else if (a.compare(0, 20, "+UVM_SAMPLE_PROFILE=") == 0) {
+                on = true;
+                m_prefix = a.substr(20);
+            } else if (a.compare(0, 23, "+UVM_SAMPLE_PROFILE_HZ=") == 0) {
+                m_hz = std::max(1, std::atoi(a.c_str() + 23));
+            } else if (a.compare(0, 24, "+UVM_SAMPLE_PROFILE_MAX=") == 0) {
+                m_capacity = std::strtoull(a.c_str() + 24, nullptr, 0);
+            }
+        }
+        if (on) start(m_hz, m_capacity);
+    }
+
+    // Function: start
+    //
+    // Installs the SIGPROF handler and arms the timer. Returns false if
+    // either fails. A running profile is stopped first, so no handler is
+    // still writing to the sample array when it is replaced.
+    bool start(int hz = 997, size_t capacity = size_t(1) << 20) {
+        stop();
+        m_samples.reset(new sample[capacity]);
+        m_capacity = capacity;
+        m_count.store(0);
+        m_lost.store(0);
+        m_hz = std::max(1, hz);
+        s_active.store(this);
+
+        struct sigaction sa = {};
+        sa.sa_sigaction = &uvm_sample_profiler::m_handler;
+        sa.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(SIGPROF, &sa, &m_old_action) != 0) {
+            s_active.store(nullptr);
+            return false;
+        }
+
+        // tv_usec must stay below one second, so rates under 1 Hz split.
+        long period_us = std::max(1L, 1000000L / m_hz);
+        itimerval tv = {};
+        tv.it_interval.tv_sec = period_us / 1000000;
+        tv.it_interval.tv_usec = period_us % 1000000;
+        tv.it_value = tv.it_interval;
+        if (setitimer(ITIMER_PROF, &tv, nullptr) != 0) {
+            s_active.store(nullptr);
+            m_quiesce();
+            sigaction(SIGPROF, &m_old_action, nullptr);
+            return false;
+        }
+        m_running = true;
+        return true;
+    }
+
+    // Function: stop
+    //
+    // Disarms the timer, waits for handlers already running on other
+    // threads to finish, and restores the previous handler. Once it
+    // returns, no handler writes to the sample array.
+    void stop() {
+        if (!m_running) return;
+        itimerval tv = {};
+        setitimer(ITIMER_PROF, &tv, nullptr);
+        s_active.store(nullptr);
+        m_quiesce();
+        sigaction(SIGPROF, &m_old_action, nullptr);
+        m_running = false;
+    }
+
+    bool is_running() const { return m_running; }
+    size_t get_sample_count() const { return std::min<size_t>(m_count.load(), m_capacity); }
+    size_t get_lost_count() const { return m_lost.load(); }
+
+    // Function: get_flat
+    //
+    // Sample counts keyed by "component", "phase" and "function" views.
+    std::map<std::string, std::map<std::string, uint64_t>> get_flat() const {
+        std::map<std::string, std::map<std::string, uint64_t>> m;
+        std::map<void*, std::string> syms;
+        for (size_t i = 0; i < get_sample_count(); i++) {
+            const sample& s = m_samples[i];
+            m["component"][s.comp ? s.comp->get_full_name() : "<none>"]++;
+            m["phase"][s.phase ? s.phase->get_name() : "<none>"]++;
+            m["function"][m_symbol(s.pc, syms)]++;
+        }
+        return m;
+    }
+
+    // Function: get_folded
+    //
+    // Collapsed stacks: one "frame;frame;... count" entry per distinct stack.
+    std::map<std::string, uint64_t> get_folded() const {
+        std::map<std::string, uint64_t> m;
+        std::map<void*, std::string> syms;
+        for (size_t i = 0; i < get_sample_count(); i++) {
+            const sample& s = m_samples[i];
+            std::string st = s.phase ? s.phase->get_name() : "<none>";
+            if (s.comp) {
+                std::string path = s.comp->get_full_name();
+                std::replace(path.begin(), path.end(), '.', ';');
+                st += ";" + path;
+            }
+            if (s.item_type) st += ";[" + m_demangle(s.item_type) + "]";
+            std::string fn = m_symbol(s.pc, syms);
+            std::replace(fn.begin(), fn.end(), ';', ':');
+            st += ";" + fn;
+            m[st]++;
+        }
+        return m;
+    }
+
+    // Function: write_reports
+    //
+    // Stops sampling and writes the flat and folded profiles.
+    bool write_reports(const std::string& prefix = "") {
+        stop();
+        std::string p = prefix.empty() ? m_prefix : prefix;
+        size_t total = get_sample_count();
+
+        std::ofstream flat(p + ".flat.txt");
+        if (!flat) return false;
+        flat << "# " << total << " samples at " << m_hz << " Hz";
+        if (get_lost_count()) flat << " (" << get_lost_count() << " lost, buffer full)";
+        flat << "\n";
+        for (const auto& view : get_flat()) {
+            std::vector<std::pair<uint64_t, std::string>> v;
+            for (const auto& e : view.second) v.push_back({e.second, e.first});
+            std::sort(v.rbegin(), v.rend());
+            flat << "\n" << std::left << std::setw(10) << "samples" << std::setw(9) << "%" << view.first << "\n";
+            for (const auto& e : v)
+                flat << std::left << std::setw(10) << e.first << std::setw(9) << std::fixed << std::setprecision(2)
+                     << (total ? 100.0 * e.first / total : 0) << e.second << "\n";
+        }
+
+        std::ofstream folded(p + ".folded");
+        if (!folded) return false;
+        for (const auto& e : get_folded()) folded << e.first << " " << e.second << "\n";
+        return bool(flat) && bool(folded);
+    }
+
+    std::string get_prefix() const { return m_prefix; }
+
+private:
+    uvm_sample_profiler() = default;
+    ~uvm_sample_profiler() { stop(); }
+
+    // Async-signal-safe: only touches the preallocated array and lock-free
+    // atomics. s_in_handler is raised before s_active is read, so once
+    // <stop> has cleared s_active and seen s_in_handler at zero, no handler
+    // can still reach the array.
+    static void m_handler(int, siginfo_t*, void* uctx) {
+        s_in_handler.fetch_add(1);
+        uvm_sample_profiler* p = s_active.load();
+        if (p) {
+            size_t i = p->m_count.fetch_add(1, std::memory_order_relaxed);
+            if (i < p->m_capacity) {
+                const uvm_profile_context& ctx = uvm_profile_context::current();
+                sample& s = p->m_samples[i];
+                s.comp = ctx.comp;
+                s.phase = ctx.phase;
+                s.item_type = ctx.item_type;
+                s.pc = m_pc(uctx);
+            } else {
+                p->m_lost.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        s_in_handler.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Waits for handlers that passed the s_active check to return.
+    static void m_quiesce() {
+        while (s_in_handler.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    }
+
+    static void* m_pc(void* uctx) {
+        const ucontext_t* uc = static_cast<const ucontext_t*>(uctx);
+#if defined(__linux__) && defined(__x86_64__)
+        return reinterpret_cast<void*>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(__aarch64__)
+        return reinterpret_cast<void*>(uc->uc_mcontext.pc);
+#else
+        (void)uc;
+        return nullptr;
+#endif
+    }
+
+    static std::string m_demangle(const char* name) {
+        int status = 0;
+        char* d = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        std::string s = status == 0 && d ? d : name;
+        std::free(d);
+        return s;
+    }
+
+    static const std::string& m_symbol(void* pc, std::map<void*, std::string>& cache) {
+        auto it = cache.find(pc);
+        if (it != cache.end()) return it->second;
+        Dl_info info = {};
+        std::string s;
+        bool found = pc && dladdr(pc, &info);
+        if (found && info.dli_sname) {
+            s = m_demangle(info.dli_sname);
+        } else if (found && info.dli_fname) {
+            std::ostringstream os;
+            os << info.dli_fname << "+0x" << std::hex
+               << (reinterpret_cast<uintptr_t>(pc) - reinterpret_cast<uintptr_t>(info.dli_fbase));
+            s = os.str();
+        } else {
+            s = "<unknown>";
+        }
+        return cache[pc] = s;
+    }
+
+    static_assert(std::atomic<uvm_sample_profiler*>::is_always_lock_free &&
+                  std::atomic<int>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free,
+                  "the SIGPROF handler needs lock-free atomics");
+
+    static inline std::atomic<uvm_sample_profiler*> s_active{nullptr};
+    static inline std::atomic<int> s_in_handler{0};
+
+    std::unique_ptr<sample[]> m_samples;
+    size_t m_capacity = size_t(1) << 20;
+    std::atomic<size_t> m_count{0};
+    std::atomic<size_t> m_lost{0};
+    struct sigaction m_old_action = {};
+    bool m_running = false;
+    int m_hz = 997;
+    std::string m_prefix = "uvm_sample_profile";
+};
+
+#endif // UVM_SAMPLE_PROFILER_H
@@ -0,0 +1,297 @@
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _UVM_SHARED_BITMEMORY_H_
+#define _UVM_SHARED_BITMEMORY_H_
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+#include "base/uvm_bitmemory.h"
+
+// Thread-safe access layer over a uvm_bitmemory shared by several ports.
+//
+// Rows are grouped in ranges of 2^stripeShift consecutive addresses and each
+// range maps onto one of a power-of-two number of lock stripes, so ports that
+// work on different address ranges do not contend. Every stripe also carries a
+// sequence counter: writers make it odd while they update a row, which lets
+// rows of up to 64 bits be read without taking the lock (load()). For that,
+// writers store row words with atomic stores and readers load them with
+// atomic loads; a row keeps its width, whatever the width of the value
+// written to it.
+//
+// All accesses to the memory must go through this layer while it is in use;
+// direct operator[] access bypasses the stripe locks. That includes
+// checkpoints and digests: checkpoint(), get_digest() and
+// get_changes_since_checkpoint() here hold every stripe while they run.
+class uvm_shared_bitmemory {
+
+  struct alignas(64) stripe {
+    std::mutex mtx;
+    std::atomic<u32> seq{0};
+  };
+
+  uvm_bitmemory & bm;
+  u_int32_t lStripeShift;
+  u_int32_t lStripeMask;
+  std::unique_ptr<stripe[]> m_stripes;
+  u64 m_row_mask;
+
+  stripe & m_stripe(u_int32_t lAddr) const { return m_stripes[(lAddr >> lStripeShift) & lStripeMask]; }
+
+  uvm_bitstream & m_row(u_int32_t lAddr) const {
+    assert(lAddr < bm.lDepth);
+    return *bm.pacbv[lAddr];
+  }
+
+  // Same bookkeeping as uvm_bitmemory::mark_dirty(), but with atomic ORs since
+  // rows of different stripes may share a bitmap word.
+  void m_mark_dirty(u_int32_t lAddr) const {
+    if (!bm.bDigestOn) return;
+    u_int32_t blk = lAddr >> bm.lBlockShift;
+    u64 bit = 1ULL << (blk & 63);
+    __atomic_fetch_or(&bm.m_dirty[blk >> 6], bit, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&bm.m_stale[blk >> 6], bit, __ATOMIC_RELAXED);
+    __atomic_store_n(&bm.bAnyStale, true, __ATOMIC_RELAXED);
+  }
+
+  u64 m_get_u64(const uvm_bitstream & row) const {
+    const u32 * w = row.get_words_ptr();
+    u64 v = __atomic_load_n(&w[0], __ATOMIC_RELAXED);
+    if (row.get_word_size() > 1) v |= (u64)__atomic_load_n(&w[1], __ATOMIC_RELAXED) << 32;
+    return v;
+  }
+
+  // Stores word i of row; bits above the row's width are dropped.
+  static void m_set_word(uvm_bitstream & row, u32 i, u32 v) {
+    u32 n = row.get_word_size();
+    if (i >= n) return;
+    if (i == n - 1 && (row.get_size() & 31)) v &= (1u << (row.get_size() & 31)) - 1;
+    __atomic_store_n(const_cast<u32 *>(row.get_words_ptr()) + i, v, __ATOMIC_RELAXED);
+  }
+
+  void m_set_u64(uvm_bitstream & row, u64 v) {
+    m_set_word(row, 0, (u32)v);
+    m_set_word(row, 1, (u32)(v >> 32));
+  }
+
+  // Copies the value of cbv into row at the row's width: missing high words
+  // are cleared, extra ones dropped.
+  static void m_set_row(uvm_bitstream & row, const uvm_bitstream & cbv) {
+    const u32 * w = cbv.get_words_ptr();
+    for (u32 i = 0, n = row.get_word_size(); i < n; i++)
+      m_set_word(row, i, i < cbv.get_word_size() ? w[i] : 0);
+  }
+
+  // Runs f(row) with the stripe locked and the sequence counter odd. f must
+  // write the row through m_set_word()/m_set_u64()/m_set_row().
+  template <typename F>
+  auto m_write(u_int32_t lAddr, F f) -> decltype(f(std::declval<uvm_bitstream &>())) {
+    stripe & s = m_stripe(lAddr);
+    std::lock_guard<std::mutex> lk(s.mtx);
+    s.seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    struct seq_close {
+      std::atomic<u32> & seq;
+      ~seq_close() { seq.fetch_add(1, std::memory_order_release); }
+    } close{s.seq};
+    m_mark_dirty(lAddr);
+    return f(m_row(lAddr));
+  }
+
+  // Runs f with every stripe locked, so no row is being written.
+  template <typename F>
+  auto m_quiesce(F f) const -> decltype(f()) {
+    std::vector<std::unique_lock<std::mutex>> lks;
+    lks.reserve(lStripeMask + 1);
+    for (u_int32_t i = 0; i <= lStripeMask; i++) lks.emplace_back(m_stripes[i].mtx);
+    return f();
+  }
+
+  public:
+
+  // nstripes is rounded up to a power of two.
+  uvm_shared_bitmemory(uvm_bitmemory & mem, u_int32_t nstripes = 64, u_int32_t stripeShift = 6)
+      : bm(mem), lStripeShift(stripeShift) {
+    u_int32_t n = 1;
+    while (n < nstripes) n <<= 1;
+    lStripeMask = n - 1;
+    m_stripes.reset(new stripe[n]);
+    m_row_mask = bm.lWidth >= 64 ? ~0ULL : ((1ULL << bm.lWidth) - 1);
+  }
+
+  uvm_shared_bitmemory(const uvm_shared_bitmemory &) = delete;
+  uvm_shared_bitmemory & operator = (const uvm_shared_bitmemory &) = delete;
+
+  uvm_bitmemory & get_memory() const { return bm; }
+
+  u_int32_t get_num_stripes() const { return lStripeMask + 1; }
+
+  // Rows of up to 64 bits
+  //----------------------
+
+  // Lock-free read. Retries while a writer holds the row's stripe.
+  u64 load(u_int32_t lAddr) const {
+    assert(bm.lWidth <= 64);
+    stripe & s = m_stripe(lAddr);
+    const uvm_bitstream & row = m_row(lAddr);
+    for (;;) {
+      u32 before = s.seq.load(std::memory_order_acquire);
+      if (before & 1) { std::this_thread::yield(); continue; }
+      u64 v = m_get_u64(row);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s.seq.load(std::memory_order_relaxed) == before) return v;
+    }
+  }
+
+  void store(u_int32_t lAddr, u64 v) {
+    assert(bm.lWidth <= 64);
+    m_write(lAddr, [&](uvm_bitstream & row) { m_set_u64(row, v); });
+  }
+
+  // The fetch_* helpers return the previous row value.
+  u64 fetch_or(u_int32_t lAddr, u64 v) {
+    assert(bm.lWidth <= 64);
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      u64 old = m_get_u64(row);
+      m_set_u64(row, old | v);
+      return old;
+    });
+  }
+
+  u64 fetch_and(u_int32_t lAddr, u64 v) {
+    assert(bm.lWidth <= 64);
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      u64 old = m_get_u64(row);
+      m_set_u64(row, old & v);
+      return old;
+    });
+  }
+
+  // Wraps modulo 2^width.
+  u64 fetch_add(u_int32_t lAddr, u64 v) {
+    assert(bm.lWidth <= 64);
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      u64 old = m_get_u64(row);
+      m_set_u64(row, old + v);
+      return old;
+    });
+  }
+
+  bool compare_exchange(u_int32_t lAddr, u64 & expected, u64 desired) {
+    assert(bm.lWidth <= 64);
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      u64 old = m_get_u64(row);
+      if (old != (expected & m_row_mask)) {
+        expected = old;
+        return false;
+      }
+      m_set_u64(row, desired);
+      return true;
+    });
+  }
+
+  // Bit i of byte_enable enables byte i of the row.
+  void write_masked(u_int32_t lAddr, u64 v, u64 byte_enable) {
+    assert(bm.lWidth <= 64);
+    u64 m = 0;
+    for (u_int32_t b = 0; b < 8; b++)
+      if (byte_enable & (1ULL << b)) m |= 0xffULL << (8 * b);
+    m_write(lAddr, [&](uvm_bitstream & row) { m_set_u64(row, (m_get_u64(row) & ~m) | (v & m)); });
+  }
+
+  // Rows of any width
+  //------------------
+
+  uvm_bitstream read(u_int32_t lAddr) const {
+    stripe & s = m_stripe(lAddr);
+    std::lock_guard<std::mutex> lk(s.mtx);
+    return m_row(lAddr);
+  }
+
+  // Writes cbv at the row's width.
+  void write(u_int32_t lAddr, const uvm_bitstream & cbv) {
+    m_write(lAddr, [&](uvm_bitstream & row) { m_set_row(row, cbv); });
+  }
+
+  uvm_bitstream fetch_or(u_int32_t lAddr, const uvm_bitstream & cbv) {
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      uvm_bitstream old(row), val(row);
+      val |= cbv;
+      m_set_row(row, val);
+      return old;
+    });
+  }
+
+  uvm_bitstream fetch_add(u_int32_t lAddr, const uvm_bitstream & cbv) {
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      uvm_bitstream old(row), val(row);
+      val += cbv;
+      m_set_row(row, val);
+      return old;
+    });
+  }
+
+  // Byte-enabled write: bit i of byte_enable (a bitstream of width/8 bits,
+  // rounded up) enables byte i of the row.
+  void write_masked(u_int32_t lAddr, const uvm_bitstream & cbv, const uvm_bitstream & byte_enable) {
+    m_write(lAddr, [&](uvm_bitstream & row) {
+      u32 n = row.get_word_size();
+      for (u32 i = 0; i < n; i++) {
+        u32 be = byte_enable.get_size() > 4 * i ? byte_enable.get_field_u32(std::min(4 * i + 3, byte_enable.get_size() - 1), 4 * i) : 0;
+        if (be == 0) continue;
+        u32 m = 0;
+        for (u32 b = 0; b < 4; b++)
+          if (be & (1u << b)) m |= 0xffu << (8 * b);
+        u32 cur = row.get_u32(i);
+        u32 val = i < cbv.get_word_size() ? cbv.get_u32(i) : 0;
+        m_set_word(row, i, (cur & ~m) | (val & m));
+      }
+    });
+  }
+
+  // Runs f on a copy of the row under the row's stripe lock, for custom
+  // read-modify-write sequences, then writes the copy back at the row's
+  // width. f must not access other rows.
+  template <typename F>
+  auto update(u_int32_t lAddr, F f) -> decltype(f(std::declval<uvm_bitstream &>())) {
+    return m_write(lAddr, [&](uvm_bitstream & row) {
+      uvm_bitstream val(row);
+      struct write_back {
+        uvm_bitstream & row;
+        const uvm_bitstream & val;
+        ~write_back() { m_set_row(row, val); }
+      } wb{row, val};
+      return f(val);
+    });
+  }
+
+  // Tracking
+  //---------
+
+  // uvm_bitmemory::checkpoint(), get_digest() and
+  // get_changes_since_checkpoint(), with all writers held off.
+  void checkpoint() { m_quiesce([this] { bm.checkpoint(); }); }
+
+  u64 get_digest() const { return m_quiesce([this] { return bm.get_digest(); }); }
+
+  void get_changes_since_checkpoint(std::vector<std::pair<u_int32_t, u_int32_t>> & ranges) const {
+    m_quiesce([&] { bm.get_changes_since_checkpoint(ranges); });
+  }
+};
+
+#endif  //_UVM_SHARED_BITMEMORY_H_
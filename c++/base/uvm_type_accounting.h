@@ -0,0 +1,257 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_TYPE_ACCOUNTING_H
+#define UVM_TYPE_ACCOUNTING_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_type_stats
+//
+// Live-instance accounting for one registered type. Creations and
+// destructions are counted in per-thread shards (one cache line each) so
+// that types allocated from many threads do not bounce a shared counter;
+// the totals are summed on read. Byte figures are live instances times
+// sizeof(T) and so do not include memory owned through pointers.
+//------------------------------------------------------------------------------
+
+class uvm_type_stats {
+public:
+    uvm_type_stats(const std::string& type_name, size_t size) : m_type_name(type_name), m_size(size) {}
+
+    void on_create() { m_shards[m_shard()].created.fetch_add(1, std::memory_order_relaxed); }
+    void on_destroy() { m_shards[m_shard()].destroyed.fetch_add(1, std::memory_order_relaxed); }
+
+    const std::string& get_type_name() const { return m_type_name; }
+    size_t get_size() const { return m_size; }
+
+    uint64_t get_created() const {
+        uint64_t n = 0;
+        for (const shard& s : m_shards) n += s.created.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    int64_t get_live() const {
+        int64_t n = 0;
+        for (const shard& s : m_shards)
+            n += s.created.load(std::memory_order_relaxed) - s.destroyed.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    uint64_t get_bytes() const { return std::max<int64_t>(get_live(), 0) * m_size; }
+
+    // Highest live count seen by <uvm_type_accounting::sample>.
+    int64_t get_high_water() const { return m_high_water.load(std::memory_order_relaxed); }
+
+    int64_t m_sample() {
+        int64_t live = get_live();
+        int64_t hw = m_high_water.load(std::memory_order_relaxed);
+        while (live > hw && !m_high_water.compare_exchange_weak(hw, live, std::memory_order_relaxed)) {}
+        return live;
+    }
+
+private:
+    static const unsigned NUM_SHARDS = 16;
+
+    struct alignas(64) shard {
+        std::atomic<uint64_t> created{0};
+        std::atomic<uint64_t> destroyed{0};
+    };
+
+    static unsigned m_shard() {
+        static std::atomic<unsigned> next{0};
+        static thread_local unsigned idx = next.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+        return idx;
+    }
+
+    std::string m_type_name;
+    size_t m_size;
+    shard m_shards[NUM_SHARDS];
+    std::atomic<int64_t> m_high_water{0};
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_type_stats_handle
+//
+// Member of <uvm_object> that ties an instance to the stats of its type.
+// The object registries attach it when they create an instance, and its
+// destructor counts the destruction. Copies of an object start detached,
+// since they were not created through a registry.
+//------------------------------------------------------------------------------
+
+class uvm_type_stats_handle {
+public:
+    uvm_type_stats_handle() = default;
+    uvm_type_stats_handle(const uvm_type_stats_handle&) {}
+    uvm_type_stats_handle& operator=(const uvm_type_stats_handle&) { return *this; }
+    ~uvm_type_stats_handle() { if (m_stats) m_stats->on_destroy(); }
+
+    void attach(uvm_type_stats* stats) {
+        if (m_stats) return;
+        m_stats = stats;
+        stats->on_create();
+    }
+
+    uvm_type_stats* get() const { return m_stats; }
+
+private:
+    uvm_type_stats* m_stats = nullptr;
+};
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_type_accounting
+//
+// Registry of <uvm_type_stats>, one per type created through
+// <uvm_object_registry> or <uvm_component_registry>.
+//
+//| +UVM_OBJECT_ACCOUNTING              dump the table in report_phase
+//| +UVM_OBJECT_ACCOUNTING_SAMPLE=<ms>  sample high-water marks every <ms>
+//
+// Without the sampler, high-water marks are only updated by explicit
+// <sample> calls (the dump takes one).
+//------------------------------------------------------------------------------
+
+class uvm_type_accounting {
+public:
+
+    static uvm_type_accounting* get() {
+        static uvm_type_accounting inst;
+        return &inst;
+    }
+
+    // Function: register_type
+    //
+    // Returns the stats of ~type_name~, creating them on first use.
+    uvm_type_stats* register_type(const std::string& type_name, size_t size) {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        for (uvm_type_stats* t : m_types)
+            if (t->get_type_name() == type_name) return t;
+        m_types.push_back(new uvm_type_stats(type_name, size));
+        return m_types.back();
+    }
+
+    std::vector<uvm_type_stats*> get_types() const {
+        std::lock_guard<std::mutex> lk(m_mtx);
+        return m_types;
+    }
+
+    // Function: sample
+    //
+    // Updates every type's high-water mark and the peak of the total bytes.
+    void sample() {
+        uint64_t total = 0;
+        for (uvm_type_stats* t : get_types()) total += std::max<int64_t>(t->m_sample(), 0) * t->get_size();
+        uint64_t peak = m_peak_bytes.load(std::memory_order_relaxed);
+        while (total > peak && !m_peak_bytes.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t get_peak_bytes() const { return m_peak_bytes.load(std::memory_order_relaxed); }
+
+    // Function: start_sampler
+    //
+    // Starts a background thread calling <sample> every ~period_ms~.
+    void start_sampler(unsigned period_ms) {
+        stop_sampler();
+        m_stop = false;
+        m_sampler = std::thread([this, period_ms] {
+            std::unique_lock<std::mutex> lk(m_sampler_mtx);
+            while (!m_sampler_cv.wait_for(lk, std::chrono::milliseconds(period_ms), [this] { return m_stop; }))
+                sample();
+        });
+    }
+
+    void stop_sampler() {
+        if (!m_sampler.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lk(m_sampler_mtx);
+            m_stop = true;
+        }
+        m_sampler_cv.notify_all();
+        m_sampler.join();
+    }
+
+    // Function: m_init
+    //
+    // Applies the +UVM_OBJECT_ACCOUNTING* plusargs; called by
+    // <uvm_root::phase_ended> with the command line plusargs when build ends.
+    void m_init(const std::vector<std::string>& plusargs) {
+        for (const std::string& a : plusargs) {
+            if (a == "+UVM_OBJECT_ACCOUNTING") {
+                m_dump_at_report = true;
+            } else if (a.compare(0, 30, "+UVM_OBJECT_ACCOUNTING_SAMPLE=") == 0) {
+                m_dump_at_report = true;
+                start_sampler(std::max(1, std::atoi(a.c_str() + 30)));
+            }
+        }
+    }
+
+    bool get_dump_at_report() const { return m_dump_at_report; }
+
+    // Function: convert2string
+    //
+    // Table of the ~top_n~ types by live bytes (all types if 0).
+    std::string convert2string(size_t top_n = 0) {
+        sample();
+        std::vector<uvm_type_stats*> v = get_types();
+        std::sort(v.begin(), v.end(), [](uvm_type_stats* a, uvm_type_stats* b) { return a->get_bytes() > b->get_bytes(); });
+        if (top_n && v.size() > top_n) v.resize(top_n);
+        uint64_t total = 0;
+        for (uvm_type_stats* t : get_types()) total += t->get_bytes();
+        std::ostringstream os;
+        os << "\n--- UVM object accounting: " << total / 1024 << " KB live, peak " << get_peak_bytes() / 1024
+           << " KB ---\n";
+        os << std::left << std::setw(12) << "live" << std::setw(14) << "bytes" << std::setw(12) << "high-water"
+           << std::setw(14) << "created" << "type\n";
+        for (uvm_type_stats* t : v)
+            os << std::left << std::setw(12) << t->get_live() << std::setw(14) << t->get_bytes() << std::setw(12)
+               << t->get_high_water() << std::setw(14) << t->get_created() << t->get_type_name() << "\n";
+        return os.str();
+    }
+
+    ~uvm_type_accounting() { stop_sampler(); }
+
+private:
+    uvm_type_accounting() = default;
+
+    mutable std::mutex m_mtx;
+    // never freed: instances destroyed during static destruction still
+    // decrement their stats after this registry is gone
+    std::vector<uvm_type_stats*> m_types;
+    std::atomic<uint64_t> m_peak_bytes{0};
+    bool m_dump_at_report = false;
+
+    std::thread m_sampler;
+    std::mutex m_sampler_mtx;
+    std::condition_variable m_sampler_cv;
+    bool m_stop = false;
+};
+
+#endif // UVM_TYPE_ACCOUNTING_H
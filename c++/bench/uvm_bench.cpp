@@ -0,0 +1,248 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// uvm_bench: throughput/latency of the core primitives. See bench/uvm_bench.h
+// for the command line.
+
+#include <thread>
+#include <vector>
+#include <string>
+
+#include "bench/uvm_bench.h"
+#include "base/uvm_bitstream.h"
+#include "base/uvm_bitmemory.h"
+#include "base/uvm_packer.h"
+#include "base/uvm_config_db.h"
+#include "base/uvm_factory.h"
+#include "base/uvm_registry.h"
+#include "base/uvm_objection.h"
+#include "base/uvm_event.h"
+#include "base/uvm_barrier.h"
+#include "base/uvm_globals.h"
+#include "base/uvm_report_object.h"
+
+class bench_item : public uvm_object {
+public:
+    UVM_OBJECT_UTILS(bench_item)
+    bench_item(const std::string& name = "bench_item") : uvm_object(name) {}
+};
+
+class bench_item_ovr : public bench_item {
+public:
+    UVM_OBJECT_UTILS(bench_item_ovr)
+    bench_item_ovr(const std::string& name = "bench_item_ovr") : bench_item(name) {}
+};
+
+// Runs peer(n) on a second thread while the caller runs self(n); used for
+// the cross-thread handoff cases.
+template <typename A, typename B>
+static void ping_pong(uint64_t n, A self, B peer) {
+    std::thread t([&] { peer(n); });
+    self(n);
+    t.join();
+}
+
+static void add_bitstream_cases(uvm_bench& b) {
+    static uvm_bitstream a128(0x12345678u, 128), b128(0x9abcdef0u, 128);
+    static uvm_bitstream a1k(0x5a5a5a5au, 1024), b1k(0xa5a5a5a5u, 1024);
+
+    b.add("bitstream/add_128", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) a128 += b128;
+        uvm_bench_keep(a128);
+    });
+    b.add("bitstream/and_xor_1024", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            a1k &= b1k;
+            a1k ^= b1k;
+        }
+        uvm_bench_keep(a1k);
+    });
+    b.add("bitstream/shift_1024", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            a1k <<= 13;
+            a1k >>= 13;
+        }
+        uvm_bench_keep(a1k);
+    });
+    b.add("bitstream/copy_1024", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            uvm_bitstream c(a1k);
+            uvm_bench_keep(c);
+        }
+    });
+    b.add("bitstream/get_field_u32", [](uint64_t n) {
+        u32 s = 0;
+        for (uint64_t i = 0; i < n; i++) s += a1k.get_field_u32(40 + (i & 511), 9 + (i & 511));
+        uvm_bench_keep(s);
+    });
+}
+
+static void add_bitmemory_cases(uvm_bench& b) {
+    static uvm_bitmemory m64(64, 4096, "m64"), x(128, 65536, "x"), y(128, 65536, "y");
+
+    b.add("bitmemory/row_write_64", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) m64[i & 4095] = (u64)i;
+    });
+    b.add("bitmemory/row_read_64", [](uint64_t n) {
+        u32 s = 0;
+        for (uint64_t i = 0; i < n; i++) s += m64[(i * 7) & 4095].get_u32();
+        uvm_bench_keep(s);
+    });
+    b.add("bitmemory/compare_64k_rows", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) uvm_bench_keep(x == y);
+    }, [] { x.enable_digest(false); y.enable_digest(false); });
+    b.add("bitmemory/compare_64k_rows_digest", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            u_int32_t a = (i * 131) & 65535;
+            x[a] = (u64)i;
+            y[a] = (u64)i;
+            x.mark_dirty(a);
+            y.mark_dirty(a);
+            uvm_bench_keep(x.digest_equal(y));
+        }
+    }, [] { x.enable_digest(true); y.enable_digest(true); });
+    b.add("bitmemory/compare_parallel_64k_rows", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            uvm_bitmemory_diff_report rpt;
+            x.compare_parallel(y, rpt);
+            uvm_bench_keep(rpt.mismatches);
+        }
+    }, [] { x.enable_digest(false); y.enable_digest(false); });
+
+    // packet reassembly: rows built elsewhere and handed to a memory
+    b.add("bitmemory/reassemble_copy_256x512", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            std::vector<uvm_bitstream> pkt(256, uvm_bitstream(0x1234u, 512));
+            uvm_bitmemory m(pkt, "pkt");
+            uvm_bench_keep(m);
+        }
+    });
+    b.add("bitmemory/reassemble_move_256x512", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            std::vector<uvm_bitstream> pkt(256, uvm_bitstream(0x1234u, 512));
+            uvm_bitmemory m(std::move(pkt), "pkt");
+            uvm_bench_keep(m);
+        }
+    });
+}
+
+static void add_packer_cases(uvm_bench& b) {
+    b.add("packer/pack_unpack_16x32", [](uint64_t n) {
+        uvm_packer p;
+        u64 s = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            p.reset();
+            for (int f = 0; f < 16; f++) p.pack_field_int(i + f, 32);
+            p.set_packed_size();
+            for (int f = 0; f < 16; f++) s += p.unpack_field_int(32);
+        }
+        uvm_bench_keep(s);
+    });
+}
+
+static void add_config_db_cases(uvm_bench& b) {
+    for (int pool : {10, 1000, 100000}) {
+        std::string tag = std::to_string(pool);
+        b.add("config_db/set_" + tag, [pool](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++)
+                uvm_config_db<int>::set(nullptr, "bench.set" + std::to_string(pool), "f" + std::to_string(i % pool), int(i));
+        });
+        b.add("config_db/get_" + tag, [pool](uint64_t n) {
+            int v = 0;
+            for (uint64_t i = 0; i < n; i++)
+                uvm_config_db<int>::get(nullptr, "bench.get" + std::to_string(pool), "f" + std::to_string((i * 7919) % pool), v);
+            uvm_bench_keep(v);
+        }, [pool] {
+            for (int i = 0; i < pool; i++)
+                uvm_config_db<int>::set(nullptr, "bench.get" + std::to_string(pool), "f" + std::to_string(i), i);
+        });
+    }
+}
+
+static void add_factory_cases(uvm_bench& b) {
+    b.add("factory/create", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) delete bench_item::type_id::create("item");
+    });
+    // registered last: the override stays in effect for the rest of the run
+    b.add("factory/create_with_override", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) delete bench_item::type_id::create("item");
+    }, [] { bench_item::type_id::set_type_override(bench_item_ovr::get_type()); });
+}
+
+static void add_objection_cases(uvm_bench& b) {
+    static uvm_objection objn("bench_objection");
+    b.add("objection/raise_drop", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            objn.raise_objection();
+            objn.drop_objection();
+        }
+    });
+}
+
+static void add_sync_cases(uvm_bench& b) {
+    b.add("mailbox/put_get", [](uint64_t n) {
+        mailbox<int> mb;
+        int v = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            mb.put(int(i));
+            mb.get(v);
+        }
+        uvm_bench_keep(v);
+    });
+    b.add("mailbox/handoff_bound1", [](uint64_t n) {
+        mailbox<int> mb(1);
+        ping_pong(n, [&](uint64_t k) { for (uint64_t i = 0; i < k; i++) mb.put(int(i)); },
+                     [&](uint64_t k) { int v; for (uint64_t i = 0; i < k; i++) mb.get(v); });
+    });
+    b.add("event/trigger_wait_roundtrip", [](uint64_t n) {
+        uvm_event ping("ping"), pong("pong");
+        ping_pong(n, [&](uint64_t k) { for (uint64_t i = 0; i < k; i++) { ping.trigger(); pong.wait_ptrigger(); pong.reset(); } },
+                     [&](uint64_t k) { for (uint64_t i = 0; i < k; i++) { ping.wait_ptrigger(); ping.reset(); pong.trigger(); } });
+    });
+    b.add("barrier/wait_for_2", [](uint64_t n) {
+        uvm_barrier bar("bar", 2);
+        auto body = [&](uint64_t k) { for (uint64_t i = 0; i < k; i++) bar.wait_for(); };
+        ping_pong(n, body, body);
+    });
+}
+
+static void add_report_cases(uvm_bench& b) {
+    static uvm_report_object rpt("bench_report");
+    b.add("report/info_filtered", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) rpt.uvm_report_info("BENCH", "filtered message", UVM_HIGH, __FILE__, __LINE__);
+    }, [] { rpt.set_report_verbosity_level(UVM_MEDIUM); });
+    b.add("report/info_logged", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) rpt.uvm_report_info("BENCH", "logged message", UVM_LOW, __FILE__, __LINE__);
+    }, [] {
+        rpt.set_report_verbosity_level(UVM_MEDIUM);
+        rpt.set_report_severity_action(UVM_INFO, UVM_LOG);
+        rpt.set_report_default_file(uvm_print::open_file("/dev/null"));
+    });
+}
+
+int main(int argc, char** argv) {
+    uvm_bench& b = uvm_bench::get();
+    add_bitstream_cases(b);
+    add_bitmemory_cases(b);
+    add_packer_cases(b);
+    add_config_db_cases(b);
+    add_objection_cases(b);
+    add_sync_cases(b);
+    add_report_cases(b);
+    add_factory_cases(b);
+    return b.run(argc, argv);
+}
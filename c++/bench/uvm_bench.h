@@ -0,0 +1,301 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_BENCH_H
+#define UVM_BENCH_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <chrono>
+#include <regex>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <unistd.h>
+#include <sys/wait.h>
+
+//------------------------------------------------------------------------------
+//
+// CLASS: uvm_bench
+//
+// Minimal microbenchmark harness for the library primitives. A case is a
+// function that performs ~n~ operations; the harness calibrates ~n~ so one
+// batch takes about <batch_ms>, then times <samples> batches and reports the
+// mean, median and 99th-percentile cost per operation.
+//
+//| uvm_bench [--filter=<regex>] [--json=<file>] [--baseline=<file>]
+//|           [--threshold=<pct>] [--samples=<n>] [--batch-ms=<ms>]
+//
+// With --baseline, each case is compared with the result of the same name in
+// a JSON file previously written with --json; cases slower by more than
+// --threshold percent (default 10) are flagged and the run exits non-zero.
+//------------------------------------------------------------------------------
+
+// Function: uvm_bench_keep
+//
+// Prevents the compiler from discarding a value computed by a benchmark.
+template <typename T>
+inline void uvm_bench_keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Function: uvm_bench_opt
+//
+// If ~a~ starts with ~key~ (e.g. "--json="), stores the rest in ~value~.
+inline bool uvm_bench_opt(const std::string& a, const char* key, std::string& value) {
+    size_t n = std::char_traits<char>::length(key);
+    if (a.compare(0, n, key) != 0) return false;
+    value = a.substr(n);
+    return true;
+}
+
+// Function: uvm_bench_rss_kb
+//
+// Resident set size of the process, in KB.
+inline long uvm_bench_rss_kb() {
+    long pages = 0, rss = 0;
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (f) {
+        if (std::fscanf(f, "%ld %ld", &pages, &rss) != 2) rss = 0;
+        std::fclose(f);
+    }
+    return rss * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Function: uvm_bench_run_child
+//
+// Runs ~body~ in a forked child, so each measurement starts from the same
+// heap, and returns what it produced through a pipe. False if the child
+// failed or exited early.
+inline bool uvm_bench_run_child(const std::function<std::string()>& body, std::string& out) {
+    int fd[2];
+    if (pipe(fd) != 0) return false;
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        close(fd[0]);
+        std::string data = body();
+        ssize_t w = write(fd[1], data.data(), data.size());
+        _exit(w == ssize_t(data.size()) ? 0 : 1);
+    }
+    close(fd[1]);
+    out.clear();
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(fd[0], buf, sizeof(buf))) > 0) out.append(buf, n);
+    close(fd[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Variant for a trivially copyable sample returned by ~body~.
+template <typename T, typename F>
+inline typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type
+uvm_bench_run_child(F body, T& out) {
+    std::string data;
+    bool ok = uvm_bench_run_child([&body] {
+        T s = body();
+        return std::string(reinterpret_cast<const char*>(&s), sizeof(s));
+    }, data);
+    if (!ok || data.size() != sizeof(out)) return false;
+    std::memcpy(&out, data.data(), sizeof(out));
+    return true;
+}
+
+class uvm_bench {
+public:
+
+    typedef std::function<void(uint64_t n)> body_t;
+
+    struct result {
+        std::string name;
+        uint64_t ops = 0;         // operations per sample
+        double mean_ns = 0;       // per operation
+        double p50_ns = 0;
+        double p99_ns = 0;
+        double mops = 0;          // million operations per second
+    };
+
+    static uvm_bench& get() {
+        static uvm_bench inst;
+        return inst;
+    }
+
+    // Function: add
+    //
+    // Registers a case. ~setup~, if given, runs once before calibration.
+    void add(const std::string& name, body_t body, std::function<void()> setup = nullptr) {
+        m_cases.push_back({name, body, setup});
+    }
+
+    // Function: run
+    //
+    // Parses the command line, runs the matching cases and returns the
+    // process exit status.
+    int run(int argc, char** argv) {
+        std::string filter = ".*", json_file, baseline_file;
+        for (int i = 1; i < argc; i++) {
+            std::string a = argv[i];
+            if (uvm_bench_opt(a, "--filter=", filter) || uvm_bench_opt(a, "--json=", json_file) ||
+                uvm_bench_opt(a, "--baseline=", baseline_file))
+                continue;
+            std::string v;
+            if (uvm_bench_opt(a, "--threshold=", v)) threshold_pct = std::atof(v.c_str());
+            else if (uvm_bench_opt(a, "--samples=", v)) samples = std::max(1, std::atoi(v.c_str()));
+            else if (uvm_bench_opt(a, "--batch-ms=", v)) batch_ms = std::atof(v.c_str());
+            else {
+                std::cerr << "uvm_bench: unknown option " << a << "\n";
+                return 2;
+            }
+        }
+
+        std::regex re(filter);
+        std::vector<result> results;
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(12) << "ns/op"
+                  << std::setw(12) << "p50" << std::setw(12) << "p99" << std::setw(12) << "Mops/s" << "\n";
+        for (const auto& c : m_cases) {
+            if (!std::regex_search(c.name, re)) continue;
+            result r = m_run_case(c);
+            std::cout << std::left << std::setw(48) << r.name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << r.mean_ns << std::setw(12) << r.p50_ns << std::setw(12) << r.p99_ns
+                      << std::setw(12) << r.mops << "\n";
+            results.push_back(r);
+        }
+
+        if (!json_file.empty() && !write_json(json_file, results)) {
+            std::cerr << "uvm_bench: cannot write " << json_file << "\n";
+            return 2;
+        }
+        if (!baseline_file.empty()) return compare(baseline_file, results) ? 0 : 1;
+        return 0;
+    }
+
+    // Function: write_json
+    //
+    // One result object per line, so baselines can be diffed and read back
+    // without a JSON library.
+    static bool write_json(const std::string& filename, const std::vector<result>& results) {
+        std::ofstream os(filename);
+        if (!os) return false;
+        os << "{\"results\":[\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const result& r = results[i];
+            os << std::fixed << std::setprecision(3)
+               << "{\"name\":\"" << r.name << "\",\"ops\":" << r.ops << ",\"mean_ns\":" << r.mean_ns
+               << ",\"p50_ns\":" << r.p50_ns << ",\"p99_ns\":" << r.p99_ns << ",\"mops\":" << r.mops << "}"
+               << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        os << "]}\n";
+        return bool(os);
+    }
+
+    // Function: read_json
+    //
+    // Reads a file written by <write_json>; returns mean_ns per case name.
+    static std::map<std::string, double> read_json(const std::string& filename) {
+        std::map<std::string, double> m;
+        std::ifstream is(filename);
+        std::string line;
+        while (std::getline(is, line)) {
+            size_t n = line.find("\"name\":\""), t = line.find("\"mean_ns\":");
+            if (n == std::string::npos || t == std::string::npos) continue;
+            n += 8;
+            m[line.substr(n, line.find('"', n) - n)] = std::atof(line.c_str() + t + 10);
+        }
+        return m;
+    }
+
+    // Function: compare
+    //
+    // Prints the change of every case against the baseline. Returns false if
+    // any case regressed by more than <threshold_pct>.
+    bool compare(const std::string& baseline_file, const std::vector<result>& results) const {
+        std::map<std::string, double> base = read_json(baseline_file);
+        bool ok = true;
+        std::cout << "\nBaseline " << baseline_file << " (threshold " << threshold_pct << "%)\n";
+        for (const result& r : results) {
+            auto it = base.find(r.name);
+            if (it == base.end() || it->second <= 0) {
+                std::cout << std::left << std::setw(48) << r.name << "   (new)\n";
+                continue;
+            }
+            double pct = 100.0 * (r.mean_ns - it->second) / it->second;
+            bool bad = pct > threshold_pct;
+            ok = ok && !bad;
+            std::cout << std::left << std::setw(48) << r.name << std::right << std::showpos << std::fixed
+                      << std::setprecision(1) << std::setw(9) << pct << "%" << std::noshowpos
+                      << (bad ? "  REGRESSION" : "") << "\n";
+        }
+        return ok;
+    }
+
+    int samples = 15;
+    double batch_ms = 20;
+    double threshold_pct = 10;
+
+private:
+    struct bench_case {
+        std::string name;
+        body_t body;
+        std::function<void()> setup;
+    };
+
+    static double m_time_ns(const body_t& body, uint64_t n) {
+        auto t0 = std::chrono::steady_clock::now();
+        body(n);
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count();
+    }
+
+    result m_run_case(const bench_case& c) const {
+        if (c.setup) c.setup();
+        // calibrate: grow n until one batch reaches batch_ms
+        uint64_t n = 1;
+        double target = batch_ms * 1e6, t = m_time_ns(c.body, n);
+        while (t < target && n < (uint64_t(1) << 40)) {
+            uint64_t next = t > 0 ? uint64_t(n * std::min(10.0, 1.2 * target / t)) : n * 10;
+            n = std::max(n + 1, next);
+            t = m_time_ns(c.body, n);
+        }
+        std::vector<double> per_op;
+        for (int s = 0; s < std::max(1, samples); s++) per_op.push_back(m_time_ns(c.body, n) / n);
+        std::sort(per_op.begin(), per_op.end());
+        result r;
+        r.name = c.name;
+        r.ops = n;
+        for (double v : per_op) r.mean_ns += v;
+        r.mean_ns /= per_op.size();
+        r.p50_ns = per_op[per_op.size() / 2];
+        r.p99_ns = per_op[std::min(per_op.size() - 1, size_t(per_op.size() * 0.99))];
+        r.mops = r.mean_ns > 0 ? 1e3 / r.mean_ns : 0;
+        return r;
+    }
+
+    std::vector<bench_case> m_cases;
+};
+
+#endif // UVM_BENCH_H
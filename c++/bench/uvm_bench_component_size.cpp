@@ -0,0 +1,139 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// uvm_bench_component_size: per-component memory footprint. Creates N idle
+// leaf components under one parent and reports sizeof(uvm_component) and the
+// resident-set growth per leaf. Each count runs in a forked child so the heap
+// starts clean. The run fails (exit status 1) when a leaf grows the resident
+// set by more than --max-bytes or sizeof(uvm_component) exceeds --max-sizeof,
+// so the footprint is tracked as a regression; the defaults below are the
+// committed budget, and 0 disables a limit.
+//
+//| uvm_bench_component_size [--components=N[,N...]] [--max-bytes=B]
+//|                          [--max-sizeof=B] [--json=<file>]
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+
+#include "base/uvm_component.h"
+#include "bench/uvm_bench.h"
+
+// Committed footprint budget; raise it only with the change that needs it.
+static const double bench_max_bytes = 2048;
+static const long bench_max_sizeof = 832;
+
+struct bench_cs_sample {
+    long components = 0;
+    double ctor_ns = 0;         // per leaf
+    double bytes = 0;           // resident-set growth per leaf
+    long lazy_allocated = 0;    // leaves with any on-demand member allocated
+};
+
+static bool bench_any_allocated(const uvm_component* c) {
+    return c->m_children.is_allocated() || c->m_children_by_handle.is_allocated() ||
+           c->m_phase_imps.is_allocated() || c->m_stream_handle.is_allocated() || c->m_tr_h.is_allocated() ||
+           c->m_config_settings.is_allocated() || c->m_verbosity_settings.is_allocated();
+}
+
+static bench_cs_sample bench_components(long n) {
+    bench_cs_sample s;
+    s.components = n;
+    uvm_component* top = new uvm_component("bench_top", nullptr);
+    std::vector<uvm_component*> leaves;
+    leaves.reserve(n);
+    long rss0 = uvm_bench_rss_kb();
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n; i++) leaves.push_back(new uvm_component("leaf" + std::to_string(i), top));
+    auto t1 = std::chrono::steady_clock::now();
+    long rss1 = uvm_bench_rss_kb();
+    for (uvm_component* c : leaves) s.lazy_allocated += bench_any_allocated(c);
+    s.ctor_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+    s.bytes = (rss1 - rss0) * 1024.0 / n;
+    return s;
+}
+
+int main(int argc, char** argv) {
+    std::vector<long> counts;
+    double max_bytes = bench_max_bytes;
+    long max_sizeof = bench_max_sizeof;
+    std::string json_file;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i], v;
+        if (uvm_bench_opt(a, "--components=", v)) {
+            std::istringstream is(v);
+            std::string tok;
+            while (std::getline(is, tok, ',')) counts.push_back(std::max(1L, std::atol(tok.c_str())));
+        }
+        else if (uvm_bench_opt(a, "--max-bytes=", v)) max_bytes = std::atof(v.c_str());
+        else if (uvm_bench_opt(a, "--max-sizeof=", v)) max_sizeof = std::atol(v.c_str());
+        else if (uvm_bench_opt(a, "--json=", v)) json_file = v;
+        else {
+            std::cerr << "uvm_bench_component_size: unknown option " << a << "\n";
+            return 2;
+        }
+    }
+    if (counts.empty()) counts = {1000, 10000, 100000};
+
+    std::vector<bench_cs_sample> rows;
+    for (long n : counts) {
+        bench_cs_sample s;
+        if (!uvm_bench_run_child([n] { return bench_components(n); }, s)) {
+            std::cerr << "uvm_bench_component_size: run with " << n << " components failed\n";
+            return 1;
+        }
+        rows.push_back(s);
+    }
+
+    std::cout << "sizeof(uvm_component)=" << sizeof(uvm_component) << "\n";
+    std::cout << std::left << std::setw(12) << "components" << std::setw(12) << "ctor ns" << std::setw(16)
+              << "bytes/component" << "lazy allocated\n" << std::fixed << std::setprecision(1);
+    for (const bench_cs_sample& s : rows)
+        std::cout << std::left << std::setw(12) << s.components << std::setw(12) << s.ctor_ns << std::setw(16)
+                  << s.bytes << s.lazy_allocated << "\n";
+
+    if (!json_file.empty()) {
+        std::ofstream os(json_file);
+        os << "{\"sizeof_component\":" << sizeof(uvm_component) << ",\"results\":[\n";
+        for (size_t i = 0; i < rows.size(); i++)
+            os << (i ? ",\n" : "") << "{\"components\":" << rows[i].components << ",\"ctor_ns\":" << rows[i].ctor_ns
+               << ",\"bytes_per_component\":" << rows[i].bytes << ",\"lazy_allocated\":" << rows[i].lazy_allocated
+               << "}";
+        os << "\n]}\n";
+    }
+
+    int status = 0;
+    if (max_sizeof > 0 && (long)sizeof(uvm_component) > max_sizeof) {
+        std::cerr << "uvm_bench_component_size: sizeof(uvm_component)=" << sizeof(uvm_component)
+                  << " exceeds --max-sizeof=" << max_sizeof << "\n";
+        status = 1;
+    }
+    for (const bench_cs_sample& s : rows) {
+        if (max_bytes > 0 && s.bytes > max_bytes) {
+            std::cerr << "uvm_bench_component_size: " << s.bytes << " bytes/component with " << s.components
+                      << " components exceeds --max-bytes=" << max_bytes << "\n";
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,301 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// uvm_bench_env: end-to-end scaling benchmark. Builds a synthetic environment
+// of N agents, each a chain of M nested components whose leaf owns K ports
+// bound to imps in the agent, sets C config entries, and runs the full phase
+// schedule with a configurable objection and message load. Every phase is
+// measured from the test's phase_started to its phase_ended: wall time and
+// resident-set growth.
+//
+//| uvm_bench_env [--agents=N[,N...]] [--depth=M] [--ports=K] [--config=C]
+//|               [--gets=G] [--objections=R] [--messages=Q] [--json=<file>]
+//
+// A list of agent counts runs one forked child per count (run_test can only
+// run once per process) and prints a phase x N scaling table; --json writes
+// one line per (N, phase). The --messages load is issued at UVM_LOW and
+// UVM_MEDIUM, so every message passes the default verbosity and is composed
+// and written; the child sends its standard output to /dev/null so the
+// messages do not bury the table.
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdio>
+
+#include "base/uvm_root.h"
+#include "base/uvm_component.h"
+#include "base/uvm_registry.h"
+#include "base/uvm_port_base.h"
+#include "base/uvm_config_db.h"
+#include "base/uvm_phase.h"
+#include "base/uvm_objection.h"
+#include "bench/uvm_bench.h"
+
+struct bench_env_cfg {
+    int agents = 1000;
+    int depth = 3;
+    int ports = 2;
+    int config = 1000;
+    int gets = 4;
+    int objections = 1;
+    int messages = 10;
+};
+
+static bench_env_cfg g_cfg;
+
+struct bench_phase_sample {
+    std::string phase;
+    double wall_ms = 0;
+    long rss_kb = 0;       // resident set at phase end
+    long rss_delta_kb = 0;
+};
+
+typedef uvm_port_base<uvm_void> bench_port;
+
+// Innermost level of an agent; owns the K ports.
+class bench_leaf : public uvm_component {
+public:
+    UVM_COMPONENT_UTILS(bench_leaf)
+
+    std::vector<bench_port*> ports;
+
+    bench_leaf(const std::string& name, uvm_component* parent) : uvm_component(name, parent) {}
+    ~bench_leaf() { for (bench_port* p : ports) delete p; }
+
+    virtual void build_phase(uvm_phase* phase) override {
+        for (int i = 0; i < g_cfg.ports; i++)
+            ports.push_back(new bench_port("port" + std::to_string(i), this, UVM_PORT));
+    }
+};
+
+// One nesting level; the last level creates the leaf.
+class bench_level : public uvm_component {
+public:
+    UVM_COMPONENT_UTILS(bench_level)
+
+    int level = 1;
+    uvm_component* child = nullptr;
+
+    bench_level(const std::string& name, uvm_component* parent) : uvm_component(name, parent) {}
+
+    virtual void build_phase(uvm_phase* phase) override {
+        uvm_config_db<int>::get(this, "", "level", level);
+        if (level + 1 < g_cfg.depth) {
+            uvm_config_db<int>::set(this, "sub", "level", level + 1);
+            child = bench_level::type_id::create("sub", this);
+        } else {
+            child = bench_leaf::type_id::create("leaf", this);
+        }
+    }
+};
+
+class bench_agent : public uvm_component {
+public:
+    UVM_COMPONENT_UTILS(bench_agent)
+
+    uvm_component* child = nullptr;
+    std::vector<bench_port*> imps;
+    int cfg_sum = 0;
+
+    bench_agent(const std::string& name, uvm_component* parent) : uvm_component(name, parent) {}
+    ~bench_agent() { for (bench_port* p : imps) delete p; }
+
+    virtual void build_phase(uvm_phase* phase) override {
+        for (int i = 0; i < g_cfg.gets; i++) {
+            int v = 0;
+            if (uvm_config_db<int>::get(this, "", "cfg" + std::to_string(i), v)) cfg_sum += v;
+        }
+        if (g_cfg.depth > 1) child = bench_level::type_id::create("sub", this);
+        else child = bench_leaf::type_id::create("leaf", this);
+        for (int i = 0; i < g_cfg.ports; i++)
+            imps.push_back(new bench_port("imp" + std::to_string(i), this, UVM_IMPLEMENTATION));
+    }
+
+    virtual void connect_phase(uvm_phase* phase) override {
+        uvm_component* c = child;
+        bench_level* l;
+        while ((l = dynamic_cast<bench_level*>(c)) != nullptr) c = l->child;
+        bench_leaf* leaf = static_cast<bench_leaf*>(c);
+        for (size_t i = 0; i < leaf->ports.size(); i++) leaf->ports[i]->connect(imps[i]);
+    }
+
+    virtual void run_phase(uvm_phase* phase) override {
+        for (int r = 0; r < g_cfg.objections; r++) {
+            phase->raise_objection(this);
+            for (int m = 0; m < g_cfg.messages; m++)
+                uvm_report_info("BENCH", "message " + std::to_string(m), m & 1 ? UVM_LOW : UVM_MEDIUM);
+            phase->drop_objection(this);
+        }
+    }
+};
+
+class bench_env : public uvm_component {
+public:
+    UVM_COMPONENT_UTILS(bench_env)
+
+    std::vector<bench_agent*> agents;
+
+    bench_env(const std::string& name, uvm_component* parent) : uvm_component(name, parent) {}
+
+    virtual void build_phase(uvm_phase* phase) override {
+        agents.reserve(g_cfg.agents);
+        for (int i = 0; i < g_cfg.agents; i++)
+            agents.push_back(bench_agent::type_id::create("agent" + std::to_string(i), this));
+    }
+};
+
+// Creates the environment and the config entries, and samples every phase.
+class bench_test : public uvm_component {
+public:
+    UVM_COMPONENT_UTILS(bench_test)
+
+    bench_env* env = nullptr;
+
+    // static so the samples outlive the test component
+    static std::vector<bench_phase_sample> samples;
+
+    bench_test(const std::string& name, uvm_component* parent) : uvm_component(name, parent) {}
+
+    virtual void build_phase(uvm_phase* phase) override {
+        // C entries spread over the agents; each agent looks up g_cfg.gets of
+        // the names, so most lookups have to search several candidates
+        for (int i = 0; i < g_cfg.config; i++) {
+            int a = g_cfg.agents ? i % g_cfg.agents : 0;
+            uvm_config_db<int>::set(this, "env.agent" + std::to_string(a), "cfg" + std::to_string(i % (g_cfg.gets + 1)), i);
+        }
+        env = bench_env::type_id::create("env", this);
+    }
+
+    virtual void phase_started(uvm_phase* phase) override {
+        m_start = std::chrono::steady_clock::now();
+        m_rss_start = uvm_bench_rss_kb();
+    }
+
+    virtual void phase_ended(uvm_phase* phase) override {
+        bench_phase_sample s;
+        s.phase = phase->get_name();
+        s.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+        s.rss_kb = uvm_bench_rss_kb();
+        s.rss_delta_kb = s.rss_kb - m_rss_start;
+        samples.push_back(s);
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    long m_rss_start = 0;
+};
+
+std::vector<bench_phase_sample> bench_test::samples;
+
+// Runs one configuration in a child process; results come back as
+// "phase wall_ms rss_kb rss_delta_kb" lines.
+static bool bench_run_child(int agents, std::vector<bench_phase_sample>& out) {
+    std::string data;
+    bool ok = uvm_bench_run_child([agents] {
+        if (!std::freopen("/dev/null", "w", stdout)) _exit(1);
+        g_cfg.agents = agents;
+        uvm_root::get()->finish_on_completion = false;
+        uvm_root::get()->run_test("bench_test");
+        std::ostringstream os;
+        for (const auto& s : bench_test::samples)
+            os << s.phase << " " << s.wall_ms << " " << s.rss_kb << " " << s.rss_delta_kb << "\n";
+        return os.str();
+    }, data);
+    std::istringstream is(data);
+    bench_phase_sample s;
+    while (is >> s.phase >> s.wall_ms >> s.rss_kb >> s.rss_delta_kb) out.push_back(s);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> agent_counts;
+    std::string json_file;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i], v;
+        if (uvm_bench_opt(a, "--agents=", v)) {
+            std::istringstream is(v);
+            std::string tok;
+            while (std::getline(is, tok, ',')) agent_counts.push_back(std::atoi(tok.c_str()));
+        }
+        else if (uvm_bench_opt(a, "--depth=", v)) g_cfg.depth = std::max(1, std::atoi(v.c_str()));
+        else if (uvm_bench_opt(a, "--ports=", v)) g_cfg.ports = std::atoi(v.c_str());
+        else if (uvm_bench_opt(a, "--config=", v)) g_cfg.config = std::atoi(v.c_str());
+        else if (uvm_bench_opt(a, "--gets=", v)) g_cfg.gets = std::atoi(v.c_str());
+        else if (uvm_bench_opt(a, "--objections=", v)) g_cfg.objections = std::atoi(v.c_str());
+        else if (uvm_bench_opt(a, "--messages=", v)) g_cfg.messages = std::atoi(v.c_str());
+        else if (uvm_bench_opt(a, "--json=", v)) json_file = v;
+        else {
+            std::cerr << "uvm_bench_env: unknown option " << a << "\n";
+            return 2;
+        }
+    }
+    if (agent_counts.empty()) agent_counts.push_back(g_cfg.agents);
+
+    std::vector<std::string> phases;
+    std::map<int, std::map<std::string, bench_phase_sample>> table;
+    for (int n : agent_counts) {
+        std::vector<bench_phase_sample> v;
+        if (!bench_run_child(n, v)) {
+            std::cerr << "uvm_bench_env: run with " << n << " agents failed\n";
+            return 1;
+        }
+        for (const auto& s : v) {
+            if (std::find(phases.begin(), phases.end(), s.phase) == phases.end()) phases.push_back(s.phase);
+            table[n][s.phase] = s;
+        }
+    }
+
+    std::cout << "depth=" << g_cfg.depth << " ports=" << g_cfg.ports << " config=" << g_cfg.config
+              << " objections=" << g_cfg.objections << " messages=" << g_cfg.messages << "\n";
+    std::cout << std::left << std::setw(28) << "phase (ms / +MB)";
+    for (int n : agent_counts) std::cout << std::right << std::setw(22) << ("N=" + std::to_string(n));
+    std::cout << "\n" << std::fixed << std::setprecision(2);
+    for (const std::string& p : phases) {
+        std::cout << std::left << std::setw(28) << p;
+        for (int n : agent_counts) {
+            const bench_phase_sample& s = table[n][p];
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(2) << s.wall_ms << " / " << s.rss_delta_kb / 1024.0;
+            std::cout << std::right << std::setw(22) << cell.str();
+        }
+        std::cout << "\n";
+    }
+
+    if (!json_file.empty()) {
+        std::ofstream os(json_file);
+        os << "{\"results\":[\n";
+        bool first = true;
+        for (int n : agent_counts)
+            for (const std::string& p : phases) {
+                const bench_phase_sample& s = table[n][p];
+                os << (first ? "" : ",\n") << "{\"agents\":" << n << ",\"depth\":" << g_cfg.depth
+                   << ",\"phase\":\"" << p << "\",\"wall_ms\":" << s.wall_ms << ",\"rss_kb\":" << s.rss_kb
+                   << ",\"rss_delta_kb\":" << s.rss_delta_kb << "}";
+                first = false;
+            }
+        os << "\n]}\n";
+    }
+    return 0;
+}
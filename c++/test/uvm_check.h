@@ -0,0 +1,42 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UVM_CHECK_H
+#define UVM_CHECK_H
+
+#include <iostream>
+
+// Minimal check helpers for the unit tests: a failed UVM_CHECK prints the
+// condition and its location and the test keeps going; main() returns
+// uvm_check_status() so ctest sees the failure.
+
+inline int& uvm_check_failures() {
+    static int n = 0;
+    return n;
+}
+
+#define UVM_CHECK(COND) \
+    do { if (!(COND)) { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #COND "\n"; \
+        uvm_check_failures()++; } } while (0)
+
+inline int uvm_check_status() {
+    if (uvm_check_failures()) std::cerr << uvm_check_failures() << " check(s) failed\n";
+    return uvm_check_failures() ? 1 : 0;
+}
+
+#endif // UVM_CHECK_H
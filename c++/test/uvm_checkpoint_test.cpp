@@ -0,0 +1,97 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Checkpoint file round trip: records written by uvm_checkpoint_writer
+// come back from uvm_checkpoint_reader with their kind, name and data, at
+// 8-byte aligned offsets; a file cut short is read as incomplete, and a
+// header with the wrong magic is refused.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "base/uvm_checkpoint.h"
+#include "test/uvm_check.h"
+
+int main() {
+    const std::string file = "uvm_checkpoint_test.ckpt";
+    const std::string cut = "uvm_checkpoint_test_cut.ckpt";
+    std::vector<u32> rows = {1, 2, 3, 4, 5};
+    const char field[] = "abc";
+
+    uvm_checkpoint_writer w;
+    UVM_CHECK(w.open(file, 1234));
+    w.write(uvm_checkpoint_format::PHASE, "post_configure");
+    w.write(uvm_checkpoint_format::COMPONENT, "uvm_test_top.env", field, 3);
+    w.begin(uvm_checkpoint_format::MEMORY, "mem", rows.size() * sizeof(u32));
+    for (u32 r : rows) w.append(&r, sizeof(r));
+    w.end();
+    UVM_CHECK(w.close());
+
+    {
+        uvm_checkpoint_reader r;
+        uvm_checkpoint_reader::record rec;
+        UVM_CHECK(r.open(file));
+        UVM_CHECK(r.get_sim_time() == 1234);
+
+        UVM_CHECK(r.next(rec));
+        UVM_CHECK(rec.kind == uvm_checkpoint_format::PHASE && rec.name == "post_configure" && rec.size == 0);
+
+        UVM_CHECK(r.next(rec));
+        UVM_CHECK(rec.kind == uvm_checkpoint_format::COMPONENT && rec.name == "uvm_test_top.env");
+        UVM_CHECK(rec.size == 3 && std::string(rec.data, 3) == "abc");
+
+        UVM_CHECK(r.next(rec));
+        UVM_CHECK(rec.kind == uvm_checkpoint_format::MEMORY && rec.name == "mem");
+        UVM_CHECK(rec.size == rows.size() * sizeof(u32));
+        UVM_CHECK(reinterpret_cast<uintptr_t>(rec.data) % 8 == 0);
+        UVM_CHECK(std::memcmp(rec.data, rows.data(), rec.size) == 0);
+
+        UVM_CHECK(!r.next(rec));
+        UVM_CHECK(r.is_complete());
+    }
+
+    // Drop the END record and half of the memory record.
+    {
+        std::ifstream is(file, std::ios::binary);
+        std::string all((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+        std::ofstream os(cut, std::ios::binary);
+        os.write(all.data(), all.size() - 24);
+    }
+    {
+        uvm_checkpoint_reader r;
+        uvm_checkpoint_reader::record rec;
+        UVM_CHECK(r.open(cut));
+        int n = 0;
+        while (r.next(rec)) n++;
+        UVM_CHECK(n == 2);
+        UVM_CHECK(!r.is_complete());
+    }
+
+    {
+        std::fstream fs(cut, std::ios::binary | std::ios::in | std::ios::out);
+        fs.write("NOTACKPT", 8);
+    }
+    uvm_checkpoint_reader bad;
+    UVM_CHECK(!bad.open(cut));
+
+    std::remove(file.c_str());
+    std::remove(cut.c_str());
+    return uvm_check_status();
+}
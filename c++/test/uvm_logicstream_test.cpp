@@ -0,0 +1,105 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Four-state truth tables of uvm_logicstream: every operand pair of
+// 0/1/Z/X through &, |, ^, ~, ===, == and ==?, checked against the
+// IEEE 1800 tables in a bit of the second word, and again through a
+// wrapped DPI buffer whose unused top-word bits are set.
+
+#include "base/uvm_logicstream.h"
+#include "test/uvm_check.h"
+
+typedef uvm_logic_value lv;
+
+static bool known(lv v) { return v == UVM_LOGIC_0 || v == UVM_LOGIC_1; }
+
+static lv ref_and(lv a, lv b) {
+    if (a == UVM_LOGIC_0 || b == UVM_LOGIC_0) return UVM_LOGIC_0;
+    return (a == UVM_LOGIC_1 && b == UVM_LOGIC_1) ? UVM_LOGIC_1 : UVM_LOGIC_X;
+}
+
+static lv ref_or(lv a, lv b) {
+    if (a == UVM_LOGIC_1 || b == UVM_LOGIC_1) return UVM_LOGIC_1;
+    return (a == UVM_LOGIC_0 && b == UVM_LOGIC_0) ? UVM_LOGIC_0 : UVM_LOGIC_X;
+}
+
+static lv ref_xor(lv a, lv b) {
+    if (!known(a) || !known(b)) return UVM_LOGIC_X;
+    return a == b ? UVM_LOGIC_0 : UVM_LOGIC_1;
+}
+
+static lv ref_not(lv a) {
+    if (!known(a)) return UVM_LOGIC_X;
+    return a == UVM_LOGIC_0 ? UVM_LOGIC_1 : UVM_LOGIC_0;
+}
+
+static lv ref_eq(lv a, lv b) {
+    if (!known(a) || !known(b)) return UVM_LOGIC_X;
+    return a == b ? UVM_LOGIC_1 : UVM_LOGIC_0;
+}
+
+static lv ref_wildcard_eq(lv a, lv pattern) {
+    if (!known(pattern)) return UVM_LOGIC_1;
+    if (!known(a)) return UVM_LOGIC_X;
+    return a == pattern ? UVM_LOGIC_1 : UVM_LOGIC_0;
+}
+
+// 40 bits, all 0 except bit 37 (in the second word).
+static uvm_logicstream one_bit(lv v) {
+    uvm_logicstream ls(40, UVM_LOGIC_0);
+    ls.set_bit(37, v);
+    return ls;
+}
+
+int main() {
+    const lv values[] = {UVM_LOGIC_0, UVM_LOGIC_1, UVM_LOGIC_Z, UVM_LOGIC_X};
+
+    for (lv a : values) {
+        uvm_logicstream la = one_bit(a);
+        UVM_CHECK((~la).get_bit(37) == ref_not(a));
+        UVM_CHECK((~la).get_bit(0) == UVM_LOGIC_1);
+        for (lv b : values) {
+            uvm_logicstream lb = one_bit(b);
+            UVM_CHECK((la & lb).get_bit(37) == ref_and(a, b));
+            UVM_CHECK((la | lb).get_bit(37) == ref_or(a, b));
+            UVM_CHECK((la ^ lb).get_bit(37) == ref_xor(a, b));
+            UVM_CHECK(la.case_equal(lb) == (a == b));
+            UVM_CHECK(la.logic_equal(lb) == ref_eq(a, b));
+            UVM_CHECK(la.wildcard_equal(lb) == ref_wildcard_eq(a, b));
+        }
+    }
+
+    // A wrapped 36-bit DPI value with garbage above bit 35: the unused bits
+    // take no part in compares, counts or conversions.
+    uvm_logic_word buf[2] = {{0x12345678u, 0}, {0xfffffff5u, 0xfffffff0u}};
+    uvm_logicstream w = uvm_logicstream::wrap(buf, 36);
+    uvm_logicstream v(36, UVM_LOGIC_0);
+    v.set_word(0, 0x12345678u);
+    v.set_word(1, 0x5u);
+    UVM_CHECK(!w.is_owner());
+    UVM_CHECK(w.case_equal(v));
+    UVM_CHECK(w == v);
+    UVM_CHECK(w.logic_equal(v) == UVM_LOGIC_1);
+    UVM_CHECK(w.wildcard_equal(v) == UVM_LOGIC_1);
+    UVM_CHECK(!w.has_unknown());
+    UVM_CHECK(w.count_x() == 0 && w.count_z() == 0);
+    UVM_CHECK(w.convert2hex() == "512345678");
+    UVM_CHECK(uvm_logicstream(w).get_word(1).aval == 0x5u);
+
+    return uvm_check_status();
+}
@@ -0,0 +1,67 @@
+//
+//------------------------------------------------------------------------------
+// Copyright 2025-2035 Smart Verification Technology Corporation (智验科技)
+// All Rights Reserved Worldwide
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Read-modify-write through uvm_shared_bitmemory: several threads apply
+// fetch_add, fetch_or and compare_exchange to the same rows and the totals
+// must come out exact; fetch_add wraps at the row width and write_masked
+// only touches the enabled bytes.
+
+#include <thread>
+#include <vector>
+
+#include "base/uvm_shared_bitmemory.h"
+#include "test/uvm_check.h"
+
+int main() {
+    const int threads = 8, iters = 20000;
+    uvm_bitmemory mem(48, 256);
+    uvm_shared_bitmemory sm(mem, 4);
+    for (u_int32_t a = 0; a < 256; a++) sm.store(a, 0);
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&sm, t] {
+            for (int i = 0; i < iters; i++) {
+                sm.fetch_add(0, 1);
+                sm.fetch_or(1, 1ULL << t);
+                u64 expected = sm.load(2);
+                while (!sm.compare_exchange(2, expected, expected + 3)) {}
+                sm.fetch_add(64 + (i & 63), 1);
+            }
+        });
+    }
+    for (auto& t : pool) t.join();
+
+    UVM_CHECK(sm.load(0) == u64(threads) * iters);
+    UVM_CHECK(sm.load(1) == (1ULL << threads) - 1);
+    UVM_CHECK(sm.load(2) == u64(threads) * iters * 3);
+    u64 spread = 0;
+    for (u_int32_t a = 64; a < 128; a++) spread += sm.load(a);
+    UVM_CHECK(spread == u64(threads) * iters);
+
+    // 48-bit rows wrap modulo 2^48.
+    sm.store(3, (1ULL << 48) - 1);
+    UVM_CHECK(sm.fetch_add(3, 2) == (1ULL << 48) - 1);
+    UVM_CHECK(sm.load(3) == 1);
+
+    sm.store(4, 0x111111111111ULL);
+    sm.write_masked(4, 0xffffffffffffULL, 0x05);
+    UVM_CHECK(sm.load(4) == 0x111111ff11ffULL);
+
+    return uvm_check_status();
+}